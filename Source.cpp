@@ -21,13 +21,26 @@ const string path{ "\\\\nask.man.ac.uk\\home$\\Visual Studio 2013\\Projects\\dat
 #include"mainMenu.h"
 
 // Declare the global data storage (Note the extern declaration in mainMenu.h)
-vector<experiment<double>*> numericExperimentVector;
-vector<experiment<string>*> stringExperimentVector;
+experimentRegistry experiments;
 
 // Set startign value for static data
-size_t timestamp::timestampCounter{ 0 };
+atomic<size_t> experimentAccounting::loadedMeasurements{ 0 };
+atomic<size_t> experimentAccounting::loadedErrors{ 0 };
+atomic<size_t> experimentAccounting::loadedBytes{ 0 };
+atomic<size_t> experimentAccounting::nextVersion{ 1 };
 
-int main() {
+int main(int argc, char* argv[]) {
+
+	// Following a live feed doesn't use the menu, so it can run unattended (eg. "program feed live.dat temperature --save live")
+	if (argc > 1 && string(argv[1]) == "feed") {
+		// The standard input gets its own buffer, so lines waiting to be read can be added together
+		ios::sync_with_stdio(false);
+		mainMenu::feed::feedSettings settings;
+		if (!mainMenu::feed::readArguments(vector<string>(argv + 2, argv + argc), settings)) { return(1); }
+		int result{ mainMenu::feed::followFeed(settings) };
+		experiments.clear();
+		return(result);
+	}
 
 	bool runCode{ true };	// Variable that keeps the program in a loop till finished
 
@@ -37,42 +50,50 @@ int main() {
 
 	while (runCode) {
 
+		// Tell the user if a save running in the background has finished
+		mainMenu::checkBackgroundSave(false);
+
 		// Print user options and number of loaded measurements:
 		cout << endl;
-		cout << timestamp::getTimestampCounter() << " measurements currently loaded" << endl;
+		cout << experimentAccounting::getLoadedMeasurements() << " measurements and " << experimentAccounting::getLoadedErrors()
+			<< " errors currently loaded (" << experimentAccounting::getLoadedBytes() / 1024 << " KB)" << endl;
 		cout << "#################################" << endl;
 		cout << "#     **Actions (Command)**     #" << endl;
 		cout << "#################################" << endl;
 		cout << "#     Load save file (load)     #" << endl;
 		cout << "#     See experiments (see)     #" << endl;
 		cout << "#    Add new experiment (new)   #" << endl;
+		cout << "#    Add many files (ingest)    #" << endl;
 		cout << "# Generate full report (report) #" << endl;
 		cout << "#     Save current data (save)  #" << endl;
+		cout << "#  Convert save file (convert)  #" << endl;
+		cout << "#      Settings (settings)      #" << endl;
 		cout << "#          Exit (exit)          #" << endl;
 		cout << "#################################" << endl;
 		cout << endl;
 
 		int answer;
-		answer = testUserInput({ {"load"},{"see"},{"new"},{"report"},{"save"},{"exit"} });
+		answer = testUserInput({ {"load"},{"see"},{"new"},{"ingest"},{"report"},{"save"},{"convert"},{"settings"},{"exit"} });
 		if (answer == 0) { mainMenu::loadData(); }
 		else if (answer == 1) { mainMenu::seeExperiments(); }
 		else if (answer == 2) { mainMenu::addExperiment(); }
-		else if (answer == 3) { mainMenu::makeReport(); }
-		else if (answer == 4) { mainMenu::saveData(); }
-		else if (answer == 5) { 
+		else if (answer == 3) { mainMenu::ingestFiles(); }
+		else if (answer == 4) { mainMenu::makeReport(); }
+		else if (answer == 5) { mainMenu::saveData(); }
+		else if (answer == 6) { mainMenu::convertSaveFile(); }
+		else if (answer == 7) { mainMenu::changeSettings(); }
+		else if (answer == 8) { 
 			cout << "Are you sure you want to exit the program? (y/n)" << endl;
 			if (testUserInput({ {"yes","y"},{"no","n"} }) == 0) { runCode = false; }
 		}
 	}
 
 
+	// Let any background save finish before exiting
+	mainMenu::checkBackgroundSave(true);
+
 	// Delete allocated data
-	for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-		delete numericExperimentVector[i];
-	}
-	for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-		delete stringExperimentVector[i];
-	}
+	experiments.clear();
 
 	return(0);
 }
\ No newline at end of file
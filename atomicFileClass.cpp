@@ -0,0 +1,96 @@
+// This file contains the definitions for the atomicFileClass.h file
+
+using namespace std;
+#include<string>
+#include<fstream>
+#include<cstdio>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+
+#include"atomicFileClass.h"
+
+// Default constructor
+atomicFile::atomicFile() : opened{ false } {}
+
+// Destructor
+atomicFile::~atomicFile() {
+	abandon();
+}
+
+// Function to start writing fileName, returning false if the temporary file can't be created
+bool atomicFile::open(const string & fileName) {
+	abandon();
+	targetName = fileName;
+	temporaryName = fileName + ".tmp";
+	file.open(temporaryName, ios::binary | ios::trunc);
+	opened = file.good();
+	if (!opened) { file.close(); remove(temporaryName.c_str()); }
+	return (opened);
+}
+
+// Function to finish writing, flushing the temporary file to disk and renaming it over the real file
+bool atomicFile::commit() {
+	if (!opened) { return (false); }
+	file.flush();
+	bool written{ file.good() };
+	file.close();
+	// The data must be on disk before the rename, otherwise a crash could leave the real file empty
+	if (!written || file.fail() || !syncFile(temporaryName)) { abandon(); return (false); }
+#ifdef _WIN32
+	bool renamed{ MoveFileExA(temporaryName.c_str(), targetName.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0 };
+#else
+	bool renamed{ rename(temporaryName.c_str(), targetName.c_str()) == 0 };
+#endif
+	if (!renamed) { abandon(); return (false); }
+	opened = false;
+	// The new file is complete either way, this only makes sure the rename itself survives a crash
+	syncFolder(targetName);
+	return (true);
+}
+
+// Function to stop writing and delete the temporary file
+void atomicFile::abandon() {
+	if (!opened) { return; }
+	file.close();
+	remove(temporaryName.c_str());
+	opened = false;
+}
+
+// Function to make sure everything written to a file has reached the disk
+bool atomicFile::syncFile(const string & fileName) {
+#ifdef _WIN32
+	HANDLE handle{ CreateFileA(fileName.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL) };
+	if (handle == INVALID_HANDLE_VALUE) { return (false); }
+	bool synced{ FlushFileBuffers(handle) != 0 };
+	CloseHandle(handle);
+	return (synced);
+#else
+	int fileDescriptor{ ::open(fileName.c_str(), O_WRONLY) };
+	if (fileDescriptor < 0) { return (false); }
+	bool synced{ fsync(fileDescriptor) == 0 };
+	::close(fileDescriptor);
+	return (synced);
+#endif
+}
+
+// Function to make sure a rename in the folder containing a file has reached the disk
+bool atomicFile::syncFolder(const string & fileName) {
+#ifdef _WIN32
+	// MoveFileEx with MOVEFILE_WRITE_THROUGH already waits for the rename to reach the disk
+	return (true);
+#else
+	size_t lastSlash{ fileName.find_last_of('/') };
+	string folder{ lastSlash == string::npos ? string(".") : fileName.substr(0, lastSlash + 1) };
+	int folderDescriptor{ ::open(folder.c_str(), O_RDONLY) };
+	if (folderDescriptor < 0) { return (false); }
+	bool synced{ fsync(folderDescriptor) == 0 };
+	::close(folderDescriptor);
+	return (synced);
+#endif
+}
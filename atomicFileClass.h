@@ -0,0 +1,55 @@
+// This header contains the atomicFile class. This writes a file through a temporary file, which only replaces the real file once
+// it is complete and on disk, so a crash or a full disk part way through a save never leaves a half written or missing file
+// Functions defined in the atomicFileClass.cpp file
+
+#ifndef ATOMIC_FILE_CLASS_H
+#define ATOMIC_FILE_CLASS_H
+
+using namespace std;
+#include<string>
+#include<fstream>
+
+// Class writing a file atomically. Data is written to fileName.tmp, which is renamed to fileName by commit()
+// If the file is closed or destroyed without commit() the temporary file is deleted and fileName is left as it was
+class atomicFile {
+private:
+	// Name of the file being written, and of the temporary file the data goes to first
+	string targetName, temporaryName;
+	// Stream writing to the temporary file
+	ofstream file;
+	// Boolean recording if the temporary file is open
+	bool opened;
+
+	// Function to make sure a rename in the folder containing a file has reached the disk (Not needed on Windows)
+	static bool syncFolder(const string & fileName);
+
+public:
+	// Function to make sure everything written to a file has reached the disk. Also used for files which are appended to
+	static bool syncFile(const string & fileName);
+
+	// Default constructor
+	atomicFile();
+
+	// Destructor (Deletes the temporary file if it wasn't committed)
+	~atomicFile();
+
+	// An atomic file owns a stream and a temporary file, so it can't be copied
+	atomicFile(const atomicFile &file) = delete;
+	atomicFile & operator=(const atomicFile &file) = delete;
+
+	// Function to start writing fileName, returning false if the temporary file can't be created
+	bool open(const string & fileName);
+
+	// Function to finish writing. The temporary file is flushed to disk and renamed over the real file
+	// Returns false, deleting the temporary file, if any step fails
+	bool commit();
+
+	// Function to stop writing and delete the temporary file
+	void abandon();
+
+	// Accesor functions
+	bool isOpen() const { return (opened); }
+	ostream & getStream() { return (file); }
+};
+
+#endif
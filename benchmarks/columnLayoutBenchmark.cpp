@@ -0,0 +1,96 @@
+// This file is a standalone benchmark comparing the old storage of experiments (an array of measurement objects) with the
+// columns now used (measurementColumnsClass.h). It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -I. benchmarks/columnLayoutBenchmark.cpp timeStampClass.cpp generalHeader.cpp stringColumnClass.cpp
+//       stringTableClass.cpp binaryFileClass.cpp -o columnLayoutBenchmark
+// and run with the number of measurements to use (10 million if none is given): ./columnLayoutBenchmark 10000000
+// Both layouts are filled with the same measurements, then the average and standard deviation are found with the same loops
+// the experiment class used before the columns, so the only difference between the timings is the layout
+
+using namespace std;
+#include<iostream>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<cmath>
+#include<random>
+#include"measurementClass.h"
+#include"measurementColumnsClass.h"
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 5) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 10000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: columnLayoutBenchmark [number of measurements]" << endl; return (1); }
+
+	// Values are drawn once, so both layouts hold exactly the same measurements
+	mt19937_64 generator{ 1 };
+	normal_distribution<double> distribution{ 100, 5 };
+	vector<double> drawn(count);
+	for (size_t i{ 0 }; i < count; i++) { drawn[i] = distribution(generator); }
+	const timestamp time{ 2018, 5, 21, 9, 0, 0 };
+
+	// Old layout: an array of measurement objects, each with its own unit string
+	measurement<double>* objects{ NULL };
+	double objectFill{ timeFunction([&]() {
+		delete[] objects;
+		objects = new measurement<double>[count];
+		for (size_t i{ 0 }; i < count; i++) { objects[i] = measurement<double>{ drawn[i], 0.1, 0, "GeV", time }; }
+	}, 1) };
+
+	// New layout: one column for each part of a measurement
+	measurementColumns<double> columns;
+	double columnFill{ timeFunction([&]() {
+		columns = measurementColumns<double>{};
+		columns.reserve(count);
+		for (size_t i{ 0 }; i < count; i++) { columns.push_back(drawn[i], 0.1, 0, "GeV", time); }
+	}, 1) };
+
+	// Average and standard deviation, as two passes over the values plus statistical errors
+	double objectAverage, objectDeviation, columnAverage, columnDeviation;
+	double objectStatistics{ timeFunction([&]() {
+		double sum{ 0 };
+		for (size_t i{ 0 }; i < count; i++) { sum += objects[i].getValue() + objects[i].getSystError(); }
+		objectAverage = sum / double(count);
+		double squares{ 0 };
+		for (size_t i{ 0 }; i < count; i++) { squares += pow(objects[i].getValue() + objects[i].getSystError() - objectAverage, 2); }
+		objectDeviation = sqrt(squares / double(count - 1));
+	}) };
+	double columnStatistics{ timeFunction([&]() {
+		const double* values{ columns.getValues().data() };
+		const double* systErrors{ columns.getSystErrors().data() };
+		double sum{ 0 };
+		for (size_t i{ 0 }; i < count; i++) { sum += values[i] + systErrors[i]; }
+		columnAverage = sum / double(count);
+		double squares{ 0 };
+		for (size_t i{ 0 }; i < count; i++) { squares += pow(values[i] + systErrors[i] - columnAverage, 2); }
+		columnDeviation = sqrt(squares / double(count - 1));
+	}) };
+
+	// Bytes held by each layout. Units of 3 letters fit inside a string object, so the objects allocate nothing else
+	size_t objectBytes{ count * sizeof(measurement<double>) };
+	size_t columnBytes{ columns.getMemoryUsage() };
+
+	cout << count << " measurements" << endl;
+	cout << "Array of objects: filled in " << objectFill << " s, average and standard deviation in " << objectStatistics << " s, "
+		<< double(objectBytes) / 1e6 << " MB (" << sizeof(measurement<double>) << " bytes per measurement)" << endl;
+	cout << "Columns:          filled in " << columnFill << " s, average and standard deviation in " << columnStatistics << " s, "
+		<< double(columnBytes) / 1e6 << " MB (" << double(columnBytes) / double(count) << " bytes per measurement)" << endl;
+	cout << "Speed up of the statistics: " << objectStatistics / columnStatistics << " times, memory used: "
+		<< double(columnBytes) / double(objectBytes) * 100 << "%" << endl;
+	// The results have to be used, or the compiler could skip the loops
+	if (objectAverage != columnAverage || objectDeviation != columnDeviation) { cout << "Warning: The layouts gave different results" << endl; }
+	cout << "Average " << columnAverage << ", standard deviation " << columnDeviation << endl;
+
+	delete[] objects;
+	return (0);
+}
@@ -0,0 +1,149 @@
+// This file is a standalone benchmark comparing the old way a data file was read in to an experiment (one pass checking every line
+// with checkMeasurementType, then a second pass splitting and converting every line again) with dataExtraction::readDataText, which
+// checks and converts each line once. It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/ingestBenchmark.cpp atomicFileClass.cpp binaryFileClass.cpp generalHeader.cpp
+//       mappedFileClass.cpp quantileSketchClass.cpp statisticsHeader.cpp stringColumnClass.cpp stringTableClass.cpp
+//       timeStampClass.cpp -o ingestBenchmark
+// and run with the number of lines in the data file (50 million if none is given): ./ingestBenchmark 50000000
+// The data file is written in the current folder as ingestBenchmark.dat and deleted at the end. It is mapped in to memory once and
+// both ways read the same text, so the timings don't include opening the file. Each way is run once, since the file is large
+// (About 36 bytes a line, so 50 million lines is 1.8 GB, and each experiment made from it about as much again)
+// The old functions are copied in oldCode.h
+
+using namespace std;
+#include<iostream>
+#include<string>
+#include<vector>
+#include<fstream>
+#include<chrono>
+#include<cstdio>
+
+// The benchmark reads from the current folder
+const string path{ "" };
+
+#include"timestampClass.h"
+#include"experimentClass.h"
+#include"generalHeader.h"
+#include"mainMenu.h"
+#include"oldCode.h"
+
+// The global data storage and static data, as in Source.cpp
+experimentRegistry experiments;
+atomic<size_t> experimentAccounting::loadedMeasurements{ 0 };
+atomic<size_t> experimentAccounting::loadedErrors{ 0 };
+atomic<size_t> experimentAccounting::loadedBytes{ 0 };
+atomic<size_t> experimentAccounting::nextVersion{ 1 };
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 1) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+// The first pass: checkMeasurementType, counting the numeric, string and error lines
+bool oldCheckMeasurementType(const string & input, vector<size_t> & counters) {
+	vector<string> substrings{ oldCode::splitString(input) };
+	if (!timestamp::validTimeStamp(substrings.back())) { return (false); }
+	for (size_t i{ 0 }; i < substrings.size(); i++) {
+		if (oldCode::makeLowerCase(substrings[i]) == "error") { counters[2]++; return (true); }
+	}
+	if (oldCode::isStringNum(substrings[0])) {
+		if (substrings.size() != 5) { return (false); }
+		if (!oldCode::isStringNum(substrings[1]) || !oldCode::isStringNum(substrings[2])) { return (false); }
+		counters[0]++;
+		return (true);
+	}
+	if (substrings.size() != 2) { return (false); }
+	counters[1]++; return (true);
+}
+
+// The old readDataFile for a numeric data file, without opening the file. Returns NULL if a line isn't valid
+experiment<double>* oldReadData(string_view fileData, const string & title) {
+	vector<size_t> counters{ 0,0,0 };
+	size_t position{ 0 };
+	string_view fileLine;
+	while (getNextLine(fileData, position, fileLine)) {
+		if (fileLine.length() != 0 && !oldCheckMeasurementType(string(fileLine), counters)) { return (NULL); }
+	}
+	if (counters[0] == 0 || counters[1] != 0) { return (NULL); }
+
+	// The second pass: readDataLine on every line, split again
+	experiment<double>* exp{ new experiment<double>{ counters[0], counters[2], title } };
+	vector<string_view> substrings;
+	position = 0;
+	while (getNextLine(fileData, position, fileLine)) {
+		if (fileLine.length() == 0) { continue; }
+		oldCode::splitStringView(fileLine, substrings);
+		timestamp time;
+		timestamp::parseTimeStamp(substrings.back(), time);
+		if (find(substrings.begin(), substrings.end(), "error") != substrings.end()) { exp->addMeasurementError(time); }
+		else {
+			double value, error, systError;
+			stringToDouble(substrings[0], value);
+			stringToDouble(substrings[1], error);
+			stringToDouble(substrings[2], systError);
+			exp->addMeasurement(value, error, systError, substrings[3], time);
+		}
+	}
+	return (exp);
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 50000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: ingestBenchmark [number of lines]" << endl; return (1); }
+
+	// Write a data file in the format of the example data, with an error line every 1000 lines
+	const string fileName{ "ingestBenchmark.dat" };
+	{
+		ofstream outputFile{ fileName, ios::binary };
+		string block;
+		for (size_t i{ 0 }; i < count; i++) {
+			timestamp time{ 2018, 5, 1 + int(i / 86400 % 28), int(i / 3600 % 24), int(i / 60 % 60), int(i % 60) };
+			if (i % 1000 == 999) { block += "error, "; }
+			else { appendToString(block, 100 + double(i % 20000) / 100); block += ", 0.5, 0, K, "; }
+			time.appendTimeString(block); block += '\n';
+			if (block.size() >= (1 << 16)) { outputFile.write(block.data(), streamsize(block.size())); block.clear(); }
+		}
+		outputFile.write(block.data(), streamsize(block.size()));
+		if (!outputFile.good()) { cout << "Warning: Could not write " << fileName << endl; return (1); }
+	}
+	mappedFile inputFile;
+	if (!inputFile.open(fileName)) { cout << "Warning: Could not open " << fileName << endl; return (1); }
+	string_view fileData{ inputFile.getData(), inputFile.getSize() };
+
+	// Only one experiment is kept at a time, so the memory needed isn't doubled
+	size_t oldMeasurements{ 0 }, oldErrors{ 0 };
+	double oldAverage{ 0 };
+	double oldTime{ timeFunction([&]() {
+		experiment<double>* exp{ oldReadData(fileData, "ingest") };
+		if (exp != NULL) { oldMeasurements = exp->getMeasurementCounter(); oldErrors = exp->getErrorCounter(); oldAverage = exp->getAverage(); }
+		delete exp;
+	}) };
+	mainMenu::dataExtraction::dataFileResult result{ false, "", NULL, NULL, 0, 0, 0 };
+	double newAverage{ 0 };
+	double newTime{ timeFunction([&]() {
+		result = mainMenu::dataExtraction::readDataText(fileData, "ingest");
+		if (result.numericExp != NULL) { newAverage = result.numericExp->getAverage(); }
+		delete result.numericExp;
+		delete result.stringExp;
+	}) };
+
+	double megabytes{ double(fileData.size()) / (1024. * 1024.) };
+	cout << count << " lines, " << megabytes << " MB, " << getStatisticsThreads() << " threads for readDataText" << endl;
+	cout << "Two passes:   " << oldTime << " s (" << megabytes / oldTime << " MB/s, " << double(count) / oldTime << " lines/s)" << endl;
+	cout << "readDataText: " << newTime << " s (" << megabytes / newTime << " MB/s, " << double(count) / newTime << " lines/s)" << endl;
+	cout << "Speed up: " << oldTime / newTime << " times" << endl;
+	if (!result.valid || oldMeasurements == 0 || oldMeasurements != result.measurements || oldErrors != result.errors
+		|| oldAverage != newAverage) {
+		cout << "Warning: The two ways read different experiments" << endl;
+	}
+	inputFile.close();
+	remove(fileName.c_str());
+	return (0);
+}
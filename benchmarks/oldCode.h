@@ -0,0 +1,113 @@
+// The functions the program used to read its files before they were replaced, kept so the benchmarks can time the old ways
+// against the new ones. They are copied as they were, since they are no longer in the program
+
+#pragma once
+#include<string>
+#include<string_view>
+#include<vector>
+#include<algorithm>
+#include<cctype>
+
+namespace oldCode {
+	inline bool isStringInt(const string & input) {
+		bool isInt{ true };
+		for (size_t i{ 0 }; i < input.length(); i++) {
+			if (!isdigit(input[i])) { isInt = false; }
+		}
+		return(isInt);
+	}
+
+	inline bool isStringNum(const string & input) {
+		bool isNum{ true };
+		size_t decimalPoints{ 0 }, numberOfDigits{ 0 };
+		size_t counter{ 0 };
+		if (input[counter] == '+' || input[counter] == '-') { counter++; }
+		while (counter < input.size()) {
+			if (input[counter] != '.') {
+				if (isdigit(input[counter])) { numberOfDigits++; }
+				else { isNum = false; }
+			}
+			else { decimalPoints++; }
+			counter++;
+		}
+		if (decimalPoints > 1 || numberOfDigits == 0) { isNum = false; }
+		return (isNum);
+	}
+
+	inline string removeWhitespace(const string & input) {
+		string output;
+		for (size_t i{ 0 }; i < input.size(); i++) {
+			if (input[i] != ' ') { output += input[i]; }
+		}
+		return (output);
+	}
+
+	// Function to split a line by commas, erasing each substring and the spaces after it from the front of a copy of the line
+	inline vector<string> splitString(string input) {
+		vector<string> output;
+		while (input.find(',') != string::npos) {
+			output.push_back(input.substr(0, input.find(',')));
+			input.erase(0, input.find(',') + 1);
+			while (input[0] == ' ' || input[0] == '\t' || input[0] == ',') { input.erase(0, 1); }
+		}
+		output.push_back(input);
+		return (output);
+	}
+
+	// Function to split a line by commas without copying, moving the front of the line past each substring and the spaces after it
+	inline void splitStringView(string_view input, vector<string_view> & output) {
+		output.clear();
+		size_t comma{ input.find(',') };
+		while (comma != string_view::npos) {
+			output.push_back(input.substr(0, comma));
+			input.remove_prefix(comma + 1);
+			while (!input.empty() && (input[0] == ' ' || input[0] == '\t' || input[0] == ',')) { input.remove_prefix(1); }
+			comma = input.find(',');
+		}
+		output.push_back(input);
+	}
+
+	inline string makeLowerCase(const string & input) {
+		string output{ input };
+		for (size_t i{ 0 }; i < input.length(); i++) {
+			output[i] = (char)tolower(input[i]);
+		}
+		return(output);
+	}
+
+	// Function to split a timestamp in to its six parts, without spaces
+	inline vector<string> splitTimeStamp(const string & input) {
+		vector<string> timeStampStrings;
+		vector<int> linePositions;
+		linePositions.push_back(-1);
+		linePositions.push_back(int(input.find('/')));
+		linePositions.push_back(int(input.find('/', linePositions[1] + 1)));
+		linePositions.push_back(int(input.find(' ')));
+		linePositions.push_back(int(input.find(':')));
+		linePositions.push_back(int(input.find(':', linePositions[4] + 1)));
+		linePositions.push_back(int(input.size()));
+		for (int i{ 0 }; i < 6; i++) {
+			string tempString{ input.substr(linePositions[i] + 1, linePositions[i + 1] - linePositions[i] - 1) };
+			timeStampStrings.push_back(removeWhitespace(tempString));
+		}
+		return (timeStampStrings);
+	}
+
+	inline bool validTimeStamp(const string input) {
+		if (count(input.begin(), input.end(), '/') != 2 || count(input.begin(), input.end(), ':') != 2) { return (false); }
+		vector<string> timeStampStrings{ splitTimeStamp(input) };
+		for (size_t i{ 0 }; i < timeStampStrings.size(); i++) {
+			if (!isStringInt(timeStampStrings[i])) { return(false); }
+		}
+		return (true);
+	}
+
+	// The string constructor of timestamp: check the string, then split it again and convert each part
+	inline bool readTimeStamp(const string & input, vector<int> & date) {
+		date = { 0, 0, 0, 0, 0, 0 };
+		if (!validTimeStamp(input)) { return (false); }
+		vector<string> timeStampStrings{ splitTimeStamp(input) };
+		for (size_t i{ 0 }; i < timeStampStrings.size(); i++) { date[i] = stoi(timeStampStrings[i]); }
+		return (true);
+	}
+}
@@ -0,0 +1,137 @@
+// This file is a standalone benchmark comparing the old way a text save file was loaded (getline on an ifstream, splitString, then
+// isStringNum and stod on each substring and a timestamp made from a string) with the mapped loader (mappedFile and
+// dataExtraction::loadTextSaveFile in mainMenu.h). It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/saveLoadBenchmark.cpp atomicFileClass.cpp binaryFileClass.cpp generalHeader.cpp
+//       mappedFileClass.cpp quantileSketchClass.cpp statisticsHeader.cpp stringColumnClass.cpp stringTableClass.cpp
+//       timeStampClass.cpp -o saveLoadBenchmark
+// and run with the number of measurements in the save file (1 million if none is given): ./saveLoadBenchmark 1000000
+// The save file is written in the current folder as SAV_loadBenchmark.dat and deleted at the end. Both ways read the same file,
+// and the experiments they make are checked against each other. The old functions are copied in oldCode.h
+
+using namespace std;
+#include<iostream>
+#include<string>
+#include<vector>
+#include<fstream>
+#include<chrono>
+#include<cstdio>
+
+// The benchmark reads from the current folder
+const string path{ "" };
+
+#include"timestampClass.h"
+#include"experimentClass.h"
+#include"generalHeader.h"
+#include"mainMenu.h"
+#include"oldCode.h"
+
+// The global data storage and static data, as in Source.cpp
+experimentRegistry experiments;
+atomic<size_t> experimentAccounting::loadedMeasurements{ 0 };
+atomic<size_t> experimentAccounting::loadedErrors{ 0 };
+atomic<size_t> experimentAccounting::loadedBytes{ 0 };
+atomic<size_t> experimentAccounting::nextVersion{ 1 };
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 3) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+// The old loop of loadData for a save file holding one numeric experiment. Returns NULL if the file can't be read
+experiment<double>* oldLoadData(const string & fileName) {
+	ifstream inputFile{ fileName };
+	if (!inputFile.good()) { return (NULL); }
+	string fileLine;
+	vector<string> substrings;
+	vector<int> date;
+	experiment<double>* tempExp{ NULL };
+	while (!inputFile.eof()) {
+		do {
+			getline(inputFile, fileLine);
+		} while (fileLine.length() == 0 && !inputFile.eof());
+		substrings = oldCode::splitString(fileLine);
+
+		if (fileLine == "NUMERIC_EXPERIMENT_BEGIN") {
+			getline(inputFile, fileLine);
+			substrings = oldCode::splitString(fileLine);
+			tempExp = new experiment<double>{ size_t(stoi(substrings[1])), size_t(stoi(substrings[2])), substrings[0] };
+			getline(inputFile, fileLine);
+			substrings = oldCode::splitString(fileLine);
+			while (fileLine != "NUMERIC_EXPERIMENT_END") {
+				if (oldCode::isStringNum(substrings[0])) {
+					// Numeric measurement
+					oldCode::readTimeStamp(substrings[4], date);
+					measurement<double> tempMes{ stod(substrings[0]), stod(substrings[1]), stod(substrings[2]), substrings[3],
+						timestamp{ date[0], date[1], date[2], date[3], date[4], date[5] } };
+					tempExp->addMeasurement(tempMes);
+				}
+				else {
+					// Error measurement
+					oldCode::readTimeStamp(substrings.back(), date);
+					tempExp->addMeasurementError(timestamp{ date[0], date[1], date[2], date[3], date[4], date[5] });
+				}
+				getline(inputFile, fileLine);
+				substrings = oldCode::splitString(fileLine);
+			}
+		}
+	}
+	return (tempExp);
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 1000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: saveLoadBenchmark [number of measurements]" << endl; return (1); }
+
+	// Write a save file of one numeric experiment, with an error measurement every 100 lines
+	const string fileName{ "SAV_loadBenchmark.dat" };
+	{
+		experiment<double> saved{ count, count / 100, "Temperature" };
+		for (size_t i{ 0 }; i < count; i++) {
+			timestamp time{ 2018, 5, 23, int(i / 3600 % 24), int(i / 60 % 60), int(i % 60) };
+			if (i % 100 == 99) { saved.addMeasurementError(time); }
+			else { saved.addMeasurement(290 + double(i % 2000) / 100, 0.05, 0.01, "K", time); }
+		}
+		ofstream outputFile{ fileName };
+		saved.writeSaveFile(outputFile);
+		if (!outputFile.good()) { cout << "Warning: Could not write " << fileName << endl; return (1); }
+	}
+
+	experiment<double>* oldExp{ NULL };
+	double oldTime{ timeFunction([&]() {
+		delete oldExp;
+		oldExp = oldLoadData(fileName);
+	}) };
+
+	// The registry is emptied before each run, or the title would already be taken
+	size_t bytes{ 0 };
+	bool valid{ false };
+	double newTime{ timeFunction([&]() {
+		experiments.clear();
+		mappedFile inputFile;
+		valid = inputFile.open(fileName) && mainMenu::dataExtraction::loadTextSaveFile(string_view{ inputFile.getData(), inputFile.getSize() });
+		bytes = inputFile.getSize();
+	}) };
+
+	double megabytes{ double(bytes) / (1024. * 1024.) };
+	cout << count << " measurements, " << megabytes << " MB, " << getStatisticsThreads() << " threads for the mapped loader" << endl;
+	cout << "getline loadData: " << oldTime << " s (" << megabytes / oldTime << " MB/s)" << endl;
+	cout << "Mapped loader:    " << newTime << " s (" << megabytes / newTime << " MB/s)" << endl;
+	cout << "Speed up: " << oldTime / newTime << " times" << endl;
+
+	vector<experiment<double>*> loaded{ experiments.getNumericExperiments() };
+	if (oldExp == NULL || !valid || loaded.size() != 1 || oldExp->getMeasurementCounter() != loaded[0]->getMeasurementCounter()
+		|| oldExp->getErrorCounter() != loaded[0]->getErrorCounter() || oldExp->getAverage() != loaded[0]->getAverage()) {
+		cout << "Warning: The two ways loaded different experiments" << endl;
+	}
+	delete oldExp;
+	experiments.clear();
+	remove(fileName.c_str());
+	return (0);
+}
@@ -0,0 +1,59 @@
+// This file is a standalone benchmark comparing the versions of summariseData (statisticsHeader.h): scalar, SSE2 and AVX2, as far as
+// this processor can run them. It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/statisticsKernelBenchmark.cpp statisticsHeader.cpp quantileSketchClass.cpp
+//       generalHeader.cpp -o statisticsKernelBenchmark
+// and run with the number of values to use (10 million if none is given): ./statisticsKernelBenchmark 10000000
+// Only 1 thread is used, so the timings are of the kernels alone. Every result is checked against the result of the scalar kernel
+
+using namespace std;
+#include<iostream>
+#include<vector>
+#include<chrono>
+#include<random>
+#include<cstring>
+#include"generalHeader.h"
+#include"statisticsHeader.h"
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 7) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 10000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: statisticsKernelBenchmark [number of values]" << endl; return (1); }
+
+	mt19937_64 generator{ 1 };
+	normal_distribution<double> distribution{ 100, 5 };
+	vector<double> values(count), offsets(count);
+	for (size_t i{ 0 }; i < count; i++) { values[i] = distribution(generator); offsets[i] = 0.01 * distribution(generator); }
+	setStatisticsThreads(1);
+
+	// The scalar kernel is timed first, as the one the others are compared with
+	vector<string> kernels{ getStatisticsKernelNames() };
+	kernels.insert(kernels.begin(), kernels.back());
+	kernels.pop_back();
+
+	cout << count << " values, 1 thread" << endl;
+	double scalarTime{ 0 };
+	dataSummary scalarSummary{ emptySummary };
+	for (size_t i{ 0 }; i < kernels.size(); i++) {
+		setStatisticsKernel(kernels[i]);
+		dataSummary summary{ emptySummary };
+		double seconds{ timeFunction([&]() { summary = summariseData(values.data(), offsets.data(), count); }) };
+		if (i == 0) { scalarTime = seconds; scalarSummary = summary; }
+		cout << getStatisticsKernelName() << ": " << seconds << " s (" << double(count) * 2 * sizeof(double) / seconds / 1e9
+			<< " GB/s), speed up over scalar " << scalarTime / seconds << " times" << endl;
+		if (memcmp(&summary, &scalarSummary, sizeof(dataSummary)) != 0) {
+			cout << "Warning: The " << getStatisticsKernelName() << " kernel gave a different result to the scalar kernel" << endl;
+		}
+	}
+	return (0);
+}
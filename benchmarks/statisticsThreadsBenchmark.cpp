@@ -0,0 +1,84 @@
+// This file is a standalone benchmark of how the statistics functions (statisticsHeader.h) scale with the number of threads
+// It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -pthread -I. benchmarks/statisticsThreadsBenchmark.cpp statisticsHeader.cpp quantileSketchClass.cpp
+//       generalHeader.cpp -o statisticsThreadsBenchmark
+// and run with the number of values and the most threads to use (10 million values and every core if none are given):
+//   ./statisticsThreadsBenchmark 10000000 8
+// Threads are started on each call with at least 4 chunks (262144 values) for every thread, so a smaller data set is also timed
+// to check the calls too small to share don't pay for starting threads. Every result is checked against the result with 1 thread,
+// since the chunks are merged in order and should give exactly the same numbers
+//
+// Recorded run ("./statisticsThreadsBenchmark 10000000 4", g++ -O2). The only machine available had 1 core, so this shows the cost
+// of the threads and that the results match, but not the speed up. A run on a machine with several cores should replace it
+//   10000000 values
+//   Threads  summariseData (s)  speed up  summariseWeightedData (s)  speed up
+//   1        0.0199             1         0.0262                     1
+//   2        0.0200             0.997     0.0266                     0.984
+//   3        0.0197             1.01      0.0253                     1.03
+//   4        0.0209             0.955     0.0263                     0.995
+//   100000 values (Done on the calling thread for any number of threads)
+//   1        7.31e-05           1         1.03e-04                   1
+//   4        7.34e-05           0.996     1.04e-04                   0.992
+
+using namespace std;
+#include<iostream>
+#include<vector>
+#include<chrono>
+#include<random>
+#include<thread>
+#include<cstring>
+#include"generalHeader.h"
+#include"statisticsHeader.h"
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 7) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+// Function to time both statistics functions on the first count values at 1 to maxThreads threads
+void benchmarkSize(const vector<double> & x, const vector<double> & y, const vector<double> & w, const size_t & count,
+	const size_t & maxThreads) {
+	cout << endl << count << " values" << endl;
+	cout << "Threads  summariseData (s)  speed up  summariseWeightedData (s)  speed up" << endl;
+	double firstSummaryTime{ 0 }, firstSumsTime{ 0 };
+	dataSummary firstSummary{ emptySummary };
+	weightedSums firstSums{};
+	for (size_t threads{ 1 }; threads <= maxThreads; threads++) {
+		setStatisticsThreads(threads);
+		dataSummary summary{ emptySummary };
+		weightedSums sums{};
+		double summaryTime{ timeFunction([&]() { summary = summariseData(x.data(), y.data(), count); }) };
+		double sumsTime{ timeFunction([&]() { sums = summariseWeightedData(x.data(), y.data(), w.data(), count); }) };
+		if (threads == 1) { firstSummaryTime = summaryTime; firstSumsTime = sumsTime; firstSummary = summary; firstSums = sums; }
+		cout << threads << "\t " << summaryTime << "\t\t    " << firstSummaryTime / summaryTime << "\t      " << sumsTime
+			<< "\t\t\t " << firstSumsTime / sumsTime << endl;
+		if (memcmp(&summary, &firstSummary, sizeof(dataSummary)) != 0 || memcmp(&sums, &firstSums, sizeof(weightedSums)) != 0) {
+			cout << "Warning: The result with " << threads << " threads is different to the result with 1 thread" << endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 10000000 }, maxThreads{ thread::hardware_concurrency() != 0 ? thread::hardware_concurrency() : 1 };
+	if ((argc > 1 && !stringToSize(argv[1], count)) || (argc > 2 && (!stringToSize(argv[2], maxThreads) || maxThreads == 0))) {
+		cout << "Usage: statisticsThreadsBenchmark [number of values] [most threads]" << endl;
+		return (1);
+	}
+
+	mt19937_64 generator{ 1 };
+	normal_distribution<double> distribution{ 100, 5 };
+	uniform_real_distribution<double> weights{ 0.5, 2 };
+	vector<double> x(count), y(count), w(count);
+	for (size_t i{ 0 }; i < count; i++) { x[i] = distribution(generator); y[i] = distribution(generator); w[i] = weights(generator); }
+
+	benchmarkSize(x, y, w, count, maxThreads);
+	if (count > 100000) { benchmarkSize(x, y, w, 100000, maxThreads); }
+	return (0);
+}
@@ -0,0 +1,74 @@
+// This file is a standalone benchmark comparing the old timestamp (six ints in a vector, with a counter of timestamps) with the
+// timestamp packed in to one 64 bit integer (timeStampClass.h). It isn't part of the program, so it is only built by hand.
+// From the main folder:
+//   g++ -std=c++17 -O2 -I. benchmarks/timestampLayoutBenchmark.cpp timeStampClass.cpp generalHeader.cpp -o timestampLayoutBenchmark
+// and run with the number of timestamps to use (10 million if none is given): ./timestampLayoutBenchmark 10000000
+// The old class is copied here with only the functions used, since it is no longer in the program
+
+using namespace std;
+#include<iostream>
+#include<vector>
+#include<chrono>
+#include"generalHeader.h"
+#include"timestampClass.h"
+
+// The timestamp class as it was before the date was packed
+class vectorTimestamp {
+private:
+	vector<int> date;	// {year, month, day, hour, minute, second}
+	static size_t timestampCounter;
+public:
+	vectorTimestamp() { date = { 0, 0, 0, 0, 0, 0 }; timestampCounter++; }
+	vectorTimestamp(const int & YY, const int & MM, const int & DD, const int & hh, const int & mm, const int & ss) {
+		date = { YY, MM, DD, hh, mm, ss }; timestampCounter++;
+	}
+	vectorTimestamp(const vectorTimestamp &tt) : vectorTimestamp() { date = tt.date; }
+	~vectorTimestamp() { timestampCounter--; }
+	vectorTimestamp & operator=(const vectorTimestamp &tt) {
+		if (&tt == this) { return (*this); }
+		date = tt.date;
+		return (*this);
+	}
+	int getSecond() const { return date[5]; }
+};
+size_t vectorTimestamp::timestampCounter{ 0 };
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 5) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+// Function to time building count timestamps in a vector and then copying the vector, for either class
+template <class T> void benchmarkClass(const string & name, const size_t & count, const size_t & heapBytes) {
+	vector<T> timestamps, copies;
+	double build{ timeFunction([&]() {
+		timestamps = vector<T>{};
+		timestamps.reserve(count);
+		for (size_t i{ 0 }; i < count; i++) { timestamps.push_back(T{ 2018, 5, 21, int(i / 3600 % 24), int(i / 60 % 60), int(i % 60) }); }
+	}) };
+	// The copies are emptied first, so every run copies in to new timestamps
+	double copy{ timeFunction([&]() { copies = vector<T>{}; copies = timestamps; }) };
+	// The results have to be used, or the compiler could skip the loops
+	volatile long long check{ 0 };
+	for (size_t i{ 0 }; i < count; i += 4096) { check = check + copies[i].getSecond(); }
+	cout << name << "built in " << build << " s, copied in " << copy << " s, " << sizeof(T) + heapBytes << " bytes per timestamp ("
+		<< sizeof(T) << " in the object, " << heapBytes << " allocated)" << endl;
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 10000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: timestampLayoutBenchmark [number of timestamps]" << endl; return (1); }
+
+	cout << count << " timestamps" << endl;
+	// Each vector of 6 ints allocates 24 bytes, which the allocator rounds up to 32
+	benchmarkClass<vectorTimestamp>("Vector of ints: ", count, 32);
+	benchmarkClass<timestamp>("Packed integer: ", count, 0);
+	return (0);
+}
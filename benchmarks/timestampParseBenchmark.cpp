@@ -0,0 +1,64 @@
+// This file is a standalone benchmark comparing the old way a timestamp was read from a string (validTimeStamp, then the string
+// constructor splitting it again in to substrings for stoi) with timestamp::parseTimeStamp. It isn't part of the program, so it is
+// only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -I. benchmarks/timestampParseBenchmark.cpp timeStampClass.cpp generalHeader.cpp -o timestampParseBenchmark
+// and run with the number of strings to read (10 million if none is given): ./timestampParseBenchmark 10000000
+// The old functions are copied in oldCode.h, since they are no longer in the program
+
+using namespace std;
+#include<iostream>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<algorithm>
+#include"generalHeader.h"
+#include"timestampClass.h"
+#include"oldCode.h"
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 3) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 10000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: timestampParseBenchmark [number of strings]" << endl; return (1); }
+
+	// A few thousand different strings in the format of the data files, read over and over
+	vector<string> inputs;
+	for (int i{ 0 }; i < 4096; i++) {
+		inputs.push_back("2018/" + to_string(1 + i % 12) + "/" + to_string(1 + i % 28) + "  " + to_string(i % 24) + ":" + to_string(i % 60)
+			+ ":" + to_string((7 * i) % 60));
+	}
+
+	// Both ways add up the seconds they read, which also checks they read the same timestamps
+	long long oldSum{ 0 }, newSum{ 0 };
+	double oldTime{ timeFunction([&]() {
+		oldSum = 0;
+		vector<int> date;
+		for (size_t i{ 0 }; i < count; i++) {
+			if (oldCode::readTimeStamp(inputs[i % inputs.size()], date)) { oldSum += date[5]; }
+		}
+	}) };
+	double newTime{ timeFunction([&]() {
+		newSum = 0;
+		timestamp time;
+		for (size_t i{ 0 }; i < count; i++) {
+			if (timestamp::parseTimeStamp(inputs[i % inputs.size()], time)) { newSum += time.getSecond(); }
+		}
+	}) };
+
+	cout << count << " timestamps read" << endl;
+	cout << "validTimeStamp and the string constructor: " << oldTime << " s (" << oldTime / double(count) * 1e9 << " ns each)" << endl;
+	cout << "parseTimeStamp:                            " << newTime << " s (" << newTime / double(count) * 1e9 << " ns each)" << endl;
+	cout << "Speed up: " << oldTime / newTime << " times" << endl;
+	if (oldSum != newSum) { cout << "Warning: The two ways read different timestamps" << endl; }
+	return (0);
+}
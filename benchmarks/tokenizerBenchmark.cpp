@@ -0,0 +1,111 @@
+// This file is a standalone benchmark comparing the old ways a line was split by commas (splitString copying the line and erasing
+// from its front, and splitStringView moving the front of the line) with splitStringView walking the line once, and stod on each
+// substring with stringToDouble. It isn't part of the program, so it is only built by hand. From the main folder:
+//   g++ -std=c++17 -O2 -I. benchmarks/tokenizerBenchmark.cpp generalHeader.cpp -o tokenizerBenchmark
+// and run with the number of times to split the short line (1 million if none is given): ./tokenizerBenchmark 1000000
+// Two lines are split: a line of a data file (39 characters), and a 12 kB line of 2000 fields, where the time of the old splitString
+// grows with the square of the length. The long line is split a thousandth as many times. First every way is checked to give the
+// same substrings as the old splitString for random lines of spaces, tabs, commas and letters. The old functions are copied in oldCode.h
+
+using namespace std;
+#include<iostream>
+#include<string>
+#include<vector>
+#include<chrono>
+#include<random>
+#include"generalHeader.h"
+#include"oldCode.h"
+
+// Function to time a function, returning the fastest of a few runs in seconds
+template <class F> double timeFunction(const F & function, const size_t & runs = 5) {
+	double fastest{ 0 };
+	for (size_t run{ 0 }; run < runs; run++) {
+		chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+		function();
+		double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+		fastest = (run == 0 || seconds < fastest) ? seconds : fastest;
+	}
+	return (fastest);
+}
+
+// Function to time splitting a line count times with each way, printing the time of each split
+void benchmarkLine(const string & name, const string & line, const size_t & count) {
+	size_t oldFields{ 0 }, movingFields{ 0 }, newFields{ 0 };
+	double oldTime{ timeFunction([&]() {
+		oldFields = 0;
+		for (size_t i{ 0 }; i < count; i++) { oldFields += oldCode::splitString(line).size(); }
+	}) };
+	vector<string_view> substrings;
+	double movingTime{ timeFunction([&]() {
+		movingFields = 0;
+		for (size_t i{ 0 }; i < count; i++) { oldCode::splitStringView(line, substrings); movingFields += substrings.size(); }
+	}) };
+	double newTime{ timeFunction([&]() {
+		newFields = 0;
+		for (size_t i{ 0 }; i < count; i++) { splitStringView(line, substrings); newFields += substrings.size(); }
+	}) };
+	cout << name << " (" << line.size() << " characters, " << substrings.size() << " fields), split " << count << " times" << endl;
+	cout << "  Old splitString:                    " << oldTime / double(count) * 1e9 << " ns each" << endl;
+	cout << "  Old splitStringView (moving front): " << movingTime / double(count) * 1e9 << " ns each" << endl;
+	cout << "  splitStringView:                    " << newTime / double(count) * 1e9 << " ns each (speed up over the old splitString "
+		<< oldTime / newTime << " times)" << endl;
+	if (oldFields != newFields || movingFields != newFields) { cout << "Warning: The ways found different numbers of fields" << endl; }
+}
+
+int main(int argc, char* argv[]) {
+	size_t count{ 1000000 };
+	if (argc > 1 && !stringToSize(argv[1], count)) { cout << "Usage: tokenizerBenchmark [number of splits]" << endl; return (1); }
+
+	// Check every way splits random lines the same as the old splitString
+	mt19937_64 generator{ 1 };
+	const string characters{ "ab ,\t,1" };
+	uniform_int_distribution<size_t> lengths{ 0, 30 }, letters{ 0, characters.size() - 1 };
+	size_t differences{ 0 };
+	vector<string_view> moving, substrings;
+	for (size_t i{ 0 }; i < 200000; i++) {
+		string line(lengths(generator), ' ');
+		for (size_t j{ 0 }; j < line.size(); j++) { line[j] = characters[letters(generator)]; }
+		vector<string> expected{ oldCode::splitString(line) };
+		oldCode::splitStringView(line, moving);
+		splitStringView(line, substrings);
+		if (vector<string>(moving.begin(), moving.end()) != expected || vector<string>(substrings.begin(), substrings.end()) != expected) {
+			differences++;
+		}
+	}
+	if (differences != 0) { cout << "Warning: " << differences << " random lines were split differently to the old splitString" << endl; }
+	else { cout << "200000 random lines split the same as the old splitString" << endl; }
+
+	string dataLine{ "76.6422, 0.5, 0, GeV, 2018/5/21  9:0:50" };
+	string longLine;
+	for (size_t i{ 0 }; i < 2000; i++) { longLine += (i == 0 ? "" : ", ") + to_string(1000 + i); }
+	benchmarkLine("Data line", dataLine, count);
+	benchmarkLine("Long line", longLine, count / 1000 != 0 ? count / 1000 : 1);
+
+	// Converting the three numbers of the data line
+	splitStringView(dataLine, substrings);
+	vector<string> fields{ oldCode::splitString(dataLine) };
+	double oldSum{ 0 }, newSum{ 0 };
+	double stodTime{ timeFunction([&]() {
+		oldSum = 0;
+		for (size_t i{ 0 }; i < count; i++) {
+			for (size_t j{ 0 }; j < 3; j++) {
+				if (oldCode::isStringNum(fields[j])) { oldSum += stod(fields[j]); }
+			}
+		}
+	}) };
+	double fromCharsTime{ timeFunction([&]() {
+		newSum = 0;
+		double number;
+		for (size_t i{ 0 }; i < count; i++) {
+			for (size_t j{ 0 }; j < 3; j++) {
+				if (stringToDouble(substrings[j], number)) { newSum += number; }
+			}
+		}
+	}) };
+	cout << "Three numbers converted " << count << " times" << endl;
+	cout << "  isStringNum and stod: " << stodTime / double(count) * 1e9 << " ns each" << endl;
+	cout << "  stringToDouble:       " << fromCharsTime / double(count) * 1e9 << " ns each (speed up " << stodTime / fromCharsTime
+		<< " times)" << endl;
+	if (oldSum != newSum) { cout << "Warning: The two ways converted different numbers" << endl; }
+	return (0);
+}
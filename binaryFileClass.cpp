@@ -0,0 +1,270 @@
+// This file contains the definitions for the binaryFileClass.h file
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<iostream>
+#include<cstdint>
+#include<cstring>
+#include<string_view>
+
+#include"binaryFileClass.h"
+
+// Ways a column can be stored in the file, written as one byte before the column
+namespace {
+	const unsigned char rawColumn{ 0 };	// Every entry stored in full
+	const unsigned char constantColumn{ 1 };	// Every entry is the same, so only one is stored
+	const unsigned char deltaColumn{ 2 };	// Each entry stored as a varint of the difference from the previous entry
+
+	// Size of the writer buffer
+	const size_t writerBufferSize{ 1 << 20 };
+
+	// Functions to store signed differences as positive integers, so small negative differences still need few bytes
+	uint64_t zigZagEncode(const uint64_t & difference) {
+		return ((difference << 1) ^ (uint64_t(0) - (difference >> 63)));
+	}
+	uint64_t zigZagDecode(const uint64_t & number) {
+		return ((number >> 1) ^ (uint64_t(0) - (number & 1)));
+	}
+}
+
+// Function returning true if this computer stores numbers with the least significant byte first
+bool isLittleEndian() {
+	const uint16_t one{ 1 };
+	unsigned char firstByte;
+	memcpy(&firstByte, &one, 1);
+	return (firstByte == 1);
+}
+
+// Function to find a 32 bit checksum (FNV-1a) of some data
+uint32_t computeChecksum(string_view data) {
+	uint32_t hash{ 2166136261u };
+	for (size_t i{ 0 }; i < data.size(); i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 16777619u;
+	}
+	return (hash);
+}
+
+// ###################### //
+// #    binaryWriter    # //
+// ###################### //
+
+// Paramatrised constructor
+binaryWriter::binaryWriter(ostream & os) : output{ os }, buffer(writerBufferSize), bufferUsed{ 0 }, bytesWritten{ 0 } {}
+
+// Destructor
+binaryWriter::~binaryWriter() {
+	flush();
+}
+
+// Function to write raw bytes
+void binaryWriter::writeBytes(const void* data, const size_t & count) {
+	const char* bytes{ static_cast<const char*>(data) };
+	bytesWritten += count;
+	if (count > buffer.size() - bufferUsed) {
+		// Not enough space, so empty the buffer. Large blocks are then written straight to the stream
+		flush();
+		if (count >= buffer.size()) { output.write(bytes, streamsize(count)); return; }
+	}
+	memcpy(buffer.data() + bufferUsed, bytes, count);
+	bufferUsed += count;
+}
+
+// Function to write a positive integer using as few bytes as possible (7 bits per byte)
+void binaryWriter::writeVarint(uint64_t number) {
+	unsigned char bytes[10];
+	size_t length{ 0 };
+	while (number >= 0x80) {
+		bytes[length] = (unsigned char)(number | 0x80);
+		number >>= 7; length++;
+	}
+	bytes[length] = (unsigned char)number; length++;
+	writeBytes(bytes, length);
+}
+
+// Function to write a string as its length followed by its characters
+void binaryWriter::writeString(string_view text) {
+	writeVarint(text.size());
+	writeBytes(text.data(), text.size());
+}
+
+// Function to write a column of numbers
+void binaryWriter::writeColumn(const vector<double> & column) {
+	if (!column.empty() && all_of(column.begin(), column.end(), [&column](const double & x) {
+		return (memcmp(&x, &column[0], sizeof(double)) == 0); })) {
+		writeNumber(constantColumn);
+		writeNumber(column[0]);
+	}
+	else {
+		writeNumber(rawColumn);
+		writeNumbers(column.data(), column.size());
+	}
+}
+
+// Function to write a column of strings. Entries are compared by their id in the table of the column
+void binaryWriter::writeColumn(const stringColumn & column) {
+	if (!column.empty() && column.isConstant()) {
+		writeNumber(constantColumn);
+		writeString(column[0]);
+	}
+	else {
+		writeNumber(rawColumn);
+		for (size_t i{ 0 }; i < column.size(); i++) { writeString(column[i]); }
+	}
+}
+
+// Function to write a column of timestamps
+void binaryWriter::writeColumn(const vector<timestamp> & column) {
+	if (!column.empty() && all_of(column.begin(), column.end(), [&column](const timestamp & x) { return (x == column[0]); })) {
+		writeNumber(constantColumn);
+		writeNumber(column[0].getPackedDate());
+	}
+	else {
+		writeNumber(deltaColumn);
+		uint64_t previous{ 0 };
+		for (size_t i{ 0 }; i < column.size(); i++) {
+			writeVarint(zigZagEncode(column[i].getPackedDate() - previous));
+			previous = column[i].getPackedDate();
+		}
+	}
+}
+
+// Function to write a vector of booleans, with 8 entries in each byte (Entry i is bit i % 8 of byte i / 8)
+void binaryWriter::writeBitmap(const vector<bool> & bits) {
+	unsigned char byte{ 0 };
+	for (size_t i{ 0 }; i < bits.size(); i++) {
+		if (bits[i]) { byte |= (unsigned char)(1 << (i % 8)); }
+		if (i % 8 == 7) { writeNumber(byte); byte = 0; }
+	}
+	if (bits.size() % 8 != 0) { writeNumber(byte); }
+}
+
+// Function to write the buffer to the stream
+bool binaryWriter::flush() {
+	if (bufferUsed != 0) { output.write(buffer.data(), streamsize(bufferUsed)); }
+	bufferUsed = 0;
+	return (output.good());
+}
+
+// ###################### //
+// #    binaryReader    # //
+// ###################### //
+
+// Paramatrised constructor
+binaryReader::binaryReader(string_view input) : data{ input }, position{ 0 }, failed{ false } {}
+
+// Function to check there are at least count bytes left, setting failed if not
+bool binaryReader::checkRemaining(const size_t & count) {
+	if (failed || count > data.size() - position) { failed = true; }
+	return (!failed);
+}
+
+// Function to read raw bytes
+bool binaryReader::readBytes(const size_t & count, string_view & output) {
+	if (!checkRemaining(count)) { return (false); }
+	output = data.substr(position, count);
+	position += count;
+	return (true);
+}
+
+// Function to read a positive integer written by writeVarint
+bool binaryReader::readVarint(uint64_t & number) {
+	number = 0;
+	for (unsigned shift{ 0 }; shift < 64; shift += 7) {
+		if (!checkRemaining(1)) { return (false); }
+		unsigned char byte{ (unsigned char)data[position] };
+		position++;
+		number |= uint64_t(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) { return (true); }
+	}
+	// More than 10 bytes can't be a valid varint
+	failed = true;
+	return (false);
+}
+
+// Function to read a string written by writeString
+bool binaryReader::readString(string_view & text) {
+	uint64_t length;
+	if (!readVarint(length)) { return (false); }
+	return (readBytes(size_t(length), text));
+}
+
+// Function to read a column of numbers
+bool binaryReader::readColumn(vector<double> & column, const size_t & count) {
+	unsigned char encoding;
+	if (!readNumber(encoding)) { return (false); }
+	if (encoding == constantColumn) {
+		double value;
+		if (!readNumber(value)) { return (false); }
+		column.assign(count, value);
+		return (true);
+	}
+	if (encoding != rawColumn || count > getRemaining() / sizeof(double)) { failed = true; return (false); }
+	column.resize(count);
+	return (readNumbers(column.data(), count));
+}
+
+// Function to read a column of strings
+bool binaryReader::readColumn(stringColumn & column, const size_t & count) {
+	unsigned char encoding;
+	string_view text;
+	if (!readNumber(encoding)) { return (false); }
+	if (encoding == constantColumn) {
+		if (!readString(text)) { return (false); }
+		column.assign(count, text);
+		return (true);
+	}
+	// Every string needs at least one byte for its length
+	if (encoding != rawColumn || count > getRemaining()) { failed = true; return (false); }
+	column.clear();
+	column.reserve(count);
+	for (size_t i{ 0 }; i < count; i++) {
+		if (!readString(text)) { return (false); }
+		column.push_back(text);
+	}
+	return (true);
+}
+
+// Function to read a column of timestamps
+bool binaryReader::readColumn(vector<timestamp> & column, const size_t & count) {
+	unsigned char encoding;
+	if (!readNumber(encoding)) { return (false); }
+	if (encoding == constantColumn) {
+		uint64_t packedDate;
+		if (!readNumber(packedDate)) { return (false); }
+		column.assign(count, timestamp::fromPackedDate(packedDate));
+		return (true);
+	}
+	if (encoding == rawColumn) {
+		if (count > getRemaining() / sizeof(uint64_t)) { failed = true; return (false); }
+		column.resize(count);
+		uint64_t packedDate;
+		for (size_t i{ 0 }; i < count; i++) {
+			readNumber(packedDate);
+			column[i] = timestamp::fromPackedDate(packedDate);
+		}
+		return (true);
+	}
+	// Every difference needs at least one byte
+	if (encoding != deltaColumn || count > getRemaining()) { failed = true; return (false); }
+	column.resize(count);
+	uint64_t previous{ 0 }, difference;
+	for (size_t i{ 0 }; i < count; i++) {
+		if (!readVarint(difference)) { return (false); }
+		previous += zigZagDecode(difference);
+		column[i] = timestamp::fromPackedDate(previous);
+	}
+	return (true);
+}
+
+// Function to read count booleans written by writeBitmap
+bool binaryReader::readBitmap(vector<bool> & bits, const size_t & count) {
+	string_view bytes;
+	if (!readBytes(count / 8 + (count % 8 != 0 ? 1 : 0), bytes)) { return (false); }
+	bits.resize(count);
+	for (size_t i{ 0 }; i < count; i++) {
+		bits[i] = ((unsigned char)bytes[i / 8] >> (i % 8)) & 1;
+	}
+	return (true);
+}
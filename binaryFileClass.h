@@ -0,0 +1,170 @@
+// This header contains the binaryWriter and binaryReader classes. These are used for binary save files, where every number is
+// stored as raw little endian bytes and each part of a measurement is stored as its own column
+// Functions defined in the binaryFileClass.cpp file
+
+#ifndef BINARY_FILE_CLASS_H
+#define BINARY_FILE_CLASS_H
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<iostream>
+#include<cstdint>
+#include<cstring>
+#include<string_view>
+#include<type_traits>
+#include<algorithm>
+#include"timestampClass.h"
+#include"stringColumnClass.h"
+
+// Function returning true if this computer stores numbers with the least significant byte first
+bool isLittleEndian();
+
+// Function to find a 32 bit checksum (FNV-1a) of some data, used to find records which were only partly written
+uint32_t computeChecksum(string_view data);
+
+// Class writing numbers and columns to an output stream in the binary save file format
+// Everything is collected in a buffer which is written to the stream once it is full, so writes to the stream are always large
+class binaryWriter {
+private:
+	// Stream the data is written to
+	ostream & output;
+	// Buffer of data not yet written to the stream
+	vector<char> buffer;
+	size_t bufferUsed;
+	// Total number of bytes written, including those still in the buffer
+	size_t bytesWritten;
+
+public:
+	// Paramatrised constructor. Data is written to the stream os
+	binaryWriter(ostream & os);
+
+	// Destructor (Writes anything left in the buffer)
+	~binaryWriter();
+
+	// A writer refers to a stream, so it can't be copied
+	binaryWriter(const binaryWriter &writer) = delete;
+	binaryWriter & operator=(const binaryWriter &writer) = delete;
+
+	// Function to write raw bytes
+	void writeBytes(const void* data, const size_t & count);
+
+	// Functions to write a number, or an array of numbers, as little endian bytes
+	template <class T> void writeNumber(const T & number);
+	template <class T> void writeNumbers(const T* numbers, const size_t & count);
+
+	// Function to write a positive integer using as few bytes as possible (7 bits per byte)
+	void writeVarint(uint64_t number);
+
+	// Function to write a string as its length followed by its characters
+	void writeString(string_view text);
+
+	// Functions to write a whole column. Columns where every entry is the same are stored as a single entry
+	// Timestamps which aren't all the same are stored as the difference from the previous timestamp, which is usually only one byte
+	void writeColumn(const vector<double> & column);
+	void writeColumn(const stringColumn & column);
+	void writeColumn(const vector<timestamp> & column);
+
+	// Function to write a vector of booleans, with 8 entries in each byte
+	void writeBitmap(const vector<bool> & bits);
+
+	// Function to write the buffer to the stream. Returns false if the stream has failed
+	bool flush();
+
+	// Accesor function for the number of bytes written so far
+	size_t getBytesWritten() const { return (bytesWritten); }
+};
+
+// Class reading numbers and columns written by binaryWriter from a block of memory, such as a mapped file
+// Every function returns false if the data ends early or isn't valid, after which all reads fail
+class binaryReader {
+private:
+	// Data being read and the position of the next byte to read
+	string_view data;
+	size_t position;
+	// Boolean recording if a read has failed
+	bool failed;
+
+	// Function to check there are at least count bytes left, setting failed if not
+	bool checkRemaining(const size_t & count);
+
+public:
+	// Paramatrised constructor. Data is read from the start of input, which must outlive the reader
+	binaryReader(string_view input);
+
+	// Function to read raw bytes. The output points in to the data rather than being copied
+	bool readBytes(const size_t & count, string_view & output);
+
+	// Functions to read a number, or an array of numbers, from little endian bytes
+	template <class T> bool readNumber(T & number);
+	template <class T> bool readNumbers(T* numbers, const size_t & count);
+
+	// Function to read a positive integer written by writeVarint
+	bool readVarint(uint64_t & number);
+
+	// Function to read a string written by writeString. The output points in to the data rather than being copied
+	bool readString(string_view & text);
+
+	// Functions to read a whole column of count entries written by writeColumn. The column is replaced
+	bool readColumn(vector<double> & column, const size_t & count);
+	bool readColumn(stringColumn & column, const size_t & count);
+	bool readColumn(vector<timestamp> & column, const size_t & count);
+
+	// Function to read count booleans written by writeBitmap
+	bool readBitmap(vector<bool> & bits, const size_t & count);
+
+	// Accesor functions
+	bool good() const { return (!failed); }
+	size_t getPosition() const { return (position); }
+	size_t getRemaining() const { return (data.size() - position); }
+};
+
+// ############################## //
+// #    Function definitions    # //
+// ############################## //
+
+// Function to write a number as little endian bytes
+template <class T> void binaryWriter::writeNumber(const T & number) {
+	static_assert(is_arithmetic<T>::value, "Only numbers can be written with writeNumber");
+	char bytes[sizeof(T)];
+	memcpy(bytes, &number, sizeof(T));
+	if (!isLittleEndian()) { reverse(bytes, bytes + sizeof(T)); }
+	writeBytes(bytes, sizeof(T));
+}
+
+// Function to write an array of numbers as little endian bytes. On little endian computers this is a single copy
+template <class T> void binaryWriter::writeNumbers(const T* numbers, const size_t & count) {
+	static_assert(is_arithmetic<T>::value, "Only numbers can be written with writeNumbers");
+	if (isLittleEndian()) { writeBytes(numbers, count * sizeof(T)); }
+	else {
+		for (size_t i{ 0 }; i < count; i++) { writeNumber(numbers[i]); }
+	}
+}
+
+// Function to read a number from little endian bytes
+template <class T> bool binaryReader::readNumber(T & number) {
+	static_assert(is_arithmetic<T>::value, "Only numbers can be read with readNumber");
+	if (!checkRemaining(sizeof(T))) { return (false); }
+	char bytes[sizeof(T)];
+	memcpy(bytes, data.data() + position, sizeof(T));
+	if (!isLittleEndian()) { reverse(bytes, bytes + sizeof(T)); }
+	memcpy(&number, bytes, sizeof(T));
+	position += sizeof(T);
+	return (true);
+}
+
+// Function to read an array of numbers from little endian bytes. On little endian computers this is a single copy
+template <class T> bool binaryReader::readNumbers(T* numbers, const size_t & count) {
+	static_assert(is_arithmetic<T>::value, "Only numbers can be read with readNumbers");
+	if (count > getRemaining() / sizeof(T) || !checkRemaining(count * sizeof(T))) { failed = true; return (false); }
+	if (isLittleEndian()) {
+		if (count != 0) { memcpy(numbers, data.data() + position, count * sizeof(T)); }
+		position += count * sizeof(T);
+	}
+	else {
+		for (size_t i{ 0 }; i < count; i++) { readNumber(numbers[i]); }
+	}
+	return (true);
+}
+
+#endif
@@ -0,0 +1,97 @@
+// This header contains the boundedQueue class. This passes items from one thread to another, holding at most a fixed number
+// of items so a fast producer can't use up all the memory before a slow consumer catches up
+// Since this is a template class everything is defined in the header
+
+#ifndef BOUNDED_QUEUE_CLASS_H
+#define BOUNDED_QUEUE_CLASS_H
+
+using namespace std;
+#include<deque>
+#include<mutex>
+#include<condition_variable>
+#include<utility>
+
+// Class template for a queue shared between threads. push waits while the queue is full, and pop waits while it is empty
+// Once the queue is closed nothing more can be pushed, and pop returns the items left then fails. Cancelling also throws away
+// the items left, for when the consumer has stopped early
+template <class T> class boundedQueue {
+private:
+	// Items in the queue and the most it can hold
+	deque<T> items;
+	size_t capacity;
+	// Booleans recording if the queue has been closed or cancelled
+	bool closed, cancelled;
+	// Lock for everything above, and conditions signalled when space or an item becomes available
+	mutex lock;
+	condition_variable notFull, notEmpty;
+
+public:
+	// Paramatrised constructor. The queue holds at most maxItems items (At least 1)
+	boundedQueue(const size_t & maxItems);
+
+	// A queue is shared between threads, so it can't be copied
+	boundedQueue(const boundedQueue &queue) = delete;
+	boundedQueue & operator=(const boundedQueue &queue) = delete;
+
+	// Function to add an item, waiting for space if the queue is full. Returns false if the queue was closed or cancelled
+	bool push(T item);
+
+	// Function to take the oldest item, waiting for one if the queue is empty. Returns false once the queue is closed and empty,
+	// or as soon as it is cancelled
+	bool pop(T & item);
+
+	// Function to stop any more items being pushed. Items already in the queue can still be taken
+	void close();
+
+	// Function to close the queue and throw away any items left in it
+	void cancel();
+};
+
+// ############################## //
+// #    Function definitions    # //
+// ############################## //
+
+// Paramatrised constructor
+template <class T> boundedQueue<T>::boundedQueue(const size_t & maxItems) :
+	capacity{ maxItems != 0 ? maxItems : 1 }, closed{ false }, cancelled{ false } {}
+
+// Function to add an item, waiting for space if the queue is full
+template <class T> bool boundedQueue<T>::push(T item) {
+	unique_lock<mutex> guard{ lock };
+	notFull.wait(guard, [this]() { return (closed || items.size() < capacity); });
+	if (closed) { return (false); }
+	items.push_back(move(item));
+	notEmpty.notify_one();
+	return (true);
+}
+
+// Function to take the oldest item, waiting for one if the queue is empty
+template <class T> bool boundedQueue<T>::pop(T & item) {
+	unique_lock<mutex> guard{ lock };
+	notEmpty.wait(guard, [this]() { return (closed || !items.empty()); });
+	if (cancelled || items.empty()) { return (false); }
+	item = move(items.front());
+	items.pop_front();
+	notFull.notify_one();
+	return (true);
+}
+
+// Function to stop any more items being pushed
+template <class T> void boundedQueue<T>::close() {
+	lock_guard<mutex> guard{ lock };
+	closed = true;
+	notFull.notify_all();
+	notEmpty.notify_all();
+}
+
+// Function to close the queue and throw away any items left in it
+template <class T> void boundedQueue<T>::cancel() {
+	lock_guard<mutex> guard{ lock };
+	closed = true;
+	cancelled = true;
+	items.clear();
+	notFull.notify_all();
+	notEmpty.notify_all();
+}
+
+#endif
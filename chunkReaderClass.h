@@ -0,0 +1,127 @@
+// This header contains the chunkReader class. This reads a large block of text, such as a mapped data or save file, as a pipeline:
+// one reader thread splits the text in to chunks of whole lines and brings them in from disk, several parser threads turn chunks
+// in to batches of parsed lines, and the calling thread uses the batches in the order of the text (eg. adding them to an experiment)
+// The threads are connected by bounded queues, so only a few chunks are in memory at once however large the text is
+// Since this is a template class everything is defined in the header
+
+#ifndef CHUNK_READER_CLASS_H
+#define CHUNK_READER_CLASS_H
+
+using namespace std;
+#include<string_view>
+#include<vector>
+#include<thread>
+#include<future>
+#include<functional>
+#include<utility>
+#include<atomic>
+#include"boundedQueueClass.h"
+
+// Class template reading text in chunks on several threads. Batch is the type each chunk is parsed in to
+template <class Batch> class chunkReader {
+private:
+	// Text being read
+	string_view text;
+	// Number of parser threads, and the size each chunk is made up to (Chunks are extended to the end of the line)
+	size_t parserThreads, chunkSize;
+
+	// Function to find the end of the chunk starting at position
+	size_t findChunkEnd(const size_t & position) const;
+
+	// Function to read one byte of every page of a chunk, so a mapped file is read from disk by the reader thread
+	static void touchPages(string_view chunk);
+
+public:
+	// Paramatrised constructor. The text must outlive the reader
+	chunkReader(string_view input, const size_t & threads, const size_t & size = size_t(1) << 22);
+
+	// Function to parse every chunk with parseChunk on the parser threads, and give the batches to useBatch in order on this thread
+	// Returns false if useBatch returns false, in which case the rest of the text is not read
+	bool run(const function<void(string_view, Batch &)> & parseChunk, const function<bool(Batch &)> & useBatch);
+};
+
+// ############################## //
+// #    Function definitions    # //
+// ############################## //
+
+// Paramatrised constructor
+template <class Batch> chunkReader<Batch>::chunkReader(string_view input, const size_t & threads, const size_t & size) :
+	text{ input }, parserThreads{ threads != 0 ? threads : 1 }, chunkSize{ size != 0 ? size : 1 } {}
+
+// Function to find the end of the chunk starting at position
+template <class Batch> size_t chunkReader<Batch>::findChunkEnd(const size_t & position) const {
+	if (text.size() - position <= chunkSize) { return (text.size()); }
+	size_t lineEnd{ text.find('\n', position + chunkSize) };
+	return (lineEnd == string_view::npos ? text.size() : lineEnd + 1);
+}
+
+// Function to read one byte of every page of a chunk
+template <class Batch> void chunkReader<Batch>::touchPages(string_view chunk) {
+	const size_t pageSize{ 4096 };
+	unsigned char sum{ 0 };
+	for (size_t i{ 0 }; i < chunk.size(); i += pageSize) { sum += (unsigned char)chunk[i]; }
+	// Stop the compiler removing the reads
+	volatile unsigned char result{ sum };
+	(void)result;
+}
+
+// Function to parse every chunk on the parser threads, using the batches in order on this thread
+template <class Batch> bool chunkReader<Batch>::run(const function<void(string_view, Batch &)> & parseChunk,
+	const function<bool(Batch &)> & useBatch) {
+	// Text that fits in one chunk isn't worth starting threads for
+	if (text.size() <= chunkSize) {
+		Batch batch;
+		parseChunk(text, batch);
+		return (useBatch(batch));
+	}
+
+	// Each chunk is given to the parsers with a promise for its batch. The matching futures are queued in the order of the text,
+	// and the size of that queue limits how many chunks can be read ahead of the batch being used
+	const size_t chunksAhead{ 2 * parserThreads + 2 };
+	boundedQueue<pair<string_view, promise<Batch>>> work{ chunksAhead };
+	boundedQueue<future<Batch>> ordered{ chunksAhead };
+
+	thread reader{ [this, &work, &ordered]() {
+		size_t position{ 0 };
+		while (position < text.size()) {
+			size_t end{ findChunkEnd(position) };
+			string_view chunk{ text.substr(position, end - position) };
+			touchPages(chunk);
+			promise<Batch> batch;
+			if (!ordered.push(batch.get_future())) { break; }
+			if (!work.push(make_pair(chunk, move(batch)))) { break; }
+			position = end;
+		}
+		work.close();
+		ordered.close();
+	} };
+	vector<thread> parsers;
+	for (size_t i{ 0 }; i < parserThreads; i++) {
+		parsers.push_back(thread{ [&work, &parseChunk]() {
+			pair<string_view, promise<Batch>> chunk;
+			while (work.pop(chunk)) {
+				Batch batch;
+				parseChunk(chunk.first, batch);
+				chunk.second.set_value(move(batch));
+			}
+		} });
+	}
+
+	// Use the batches in order. If useBatch stops early the queues are cancelled, so the other threads finish straight away
+	bool completed{ true };
+	future<Batch> next;
+	while (ordered.pop(next)) {
+		Batch batch{ next.get() };
+		if (!useBatch(batch)) {
+			completed = false;
+			ordered.cancel();
+			work.cancel();
+			break;
+		}
+	}
+	reader.join();
+	for (size_t i{ 0 }; i < parsers.size(); i++) { parsers[i].join(); }
+	return (completed);
+}
+
+#endif
@@ -7,39 +7,118 @@
 #include<sstream>
 #include<tuple>
 #include<algorithm>
+#include<atomic>
+#include<string_view>
+#include<type_traits>
+#include<numeric>
+#include<cmath>
 #include"measurementClass.h"
+#include"measurementColumnsClass.h"
+#include"binaryFileClass.h"
+#include"statisticsHeader.h"
+#include"stringTableClass.h"
 
 using namespace std;
 
+// Class keeping count of everything stored in experiments across the whole program
+// Experiments update the counters after a batch of measurements has been added (see experiment::updateAccounting),
+// never once per measurement, and they are atomic so experiments can be built on other threads
+class experimentAccounting {
+private:
+	// Static data for the number of measurements, errors and bytes of measurement storage in all experiments
+	static atomic<size_t> loadedMeasurements, loadedErrors, loadedBytes;
+	// Static data for the next version number given to an experiment
+	static atomic<size_t> nextVersion;
+public:
+	// Functions to add and remove storage from the counters
+	static void addStorage(const size_t & mc, const size_t & ec, const size_t & bytes) {
+		loadedMeasurements.fetch_add(mc, memory_order_relaxed);
+		loadedErrors.fetch_add(ec, memory_order_relaxed);
+		loadedBytes.fetch_add(bytes, memory_order_relaxed);
+	}
+	static void removeStorage(const size_t & mc, const size_t & ec, const size_t & bytes) {
+		loadedMeasurements.fetch_sub(mc, memory_order_relaxed);
+		loadedErrors.fetch_sub(ec, memory_order_relaxed);
+		loadedBytes.fetch_sub(bytes, memory_order_relaxed);
+	}
+
+	// Static accesor functions for the program wide counters
+	static size_t getLoadedMeasurements() { return (loadedMeasurements.load(memory_order_relaxed)); }
+	static size_t getLoadedErrors() { return (loadedErrors.load(memory_order_relaxed)); }
+	static size_t getLoadedBytes() { return (loadedBytes.load(memory_order_relaxed)); }
+
+	// Function returning a version number which has never been given out before (see experiment::version)
+	static size_t newVersion() { return (nextVersion.fetch_add(1, memory_order_relaxed)); }
+};
+
+// Structure keeping the weighted sums of the last linear fit done by an experiment, so the next fit with the same dependent
+// experiment only has to add the rows input since. The sums are of x and y less the first valid row, so large values with a
+// small spread don't lose precision
+struct linearFitCache {
+	size_t version, depVersion;	// Versions of both experiments when the sums were found
+	size_t rows, index, depIndex;	// Rows of input used, and the measurements of each experiment in those rows
+	size_t entries;	// Rows used in the fit (Rows which aren't an error in either experiment)
+	double xShift, yShift;	// Values subtracted from x and y
+	weightedSums sums;
+	bool fitted;	// True once a fit has been found from the sums
+	double gradient, intercept, chiSq;	// Results of the last fit, with the intercept of the shifted values
+};
+
 // Template class for experiments
 template <class V> class experiment{
 
 protected:
-	// Counter to track the number of measurements
-	size_t measurementCounter;
-	// Container of valid measurements in the experiment
-	measurement<V>* measurements;
-	// Integer counting the number of measurement errors in the experiment
-	size_t errorCounter;
-	// Container of error messages in the measurements. All inherited class will have this
-	measurement<string>* measurementErrors;
+	// Columns storing the valid measurements in the experiment
+	measurementColumns<V> measurements;
+	// Timestamps of the measurement errors in the experiment. All inherited class will have this
+	vector<timestamp> errorTimes;
 	// String recording the title of an experiment
 	string title;
-	// A vector of pairs which can record the order of input of measurements
-	// Pair specifies type and index in that order eg (numeric, 3),(error, 5)
-	vector<pair<string, size_t>> orderVector;
+	// A vector recording the order of input of measurements. True entries are errors and false entries are valid measurements,
+	// so the nth false entry is measurement n and the nth true entry is error n
+	vector<bool> errorOrder;
 	// A vector of experiment pointers for both types to track correlated measurements
 	vector<experiment<double>*> numericCorrelatedVector;
 	vector<experiment<string>*> stringCorrelatedVector;
+	// Storage last added to the program wide counters in experimentAccounting (measurements, errors, bytes)
+	size_t accountedMeasurements, accountedErrors, accountedBytes;
+	// Quantile sketch of the values plus their systematic errors, the same numbers as the running summary, kept up to date as
+	// measurements are added (String experiments leave it empty)
+	quantileSketch valueSketch;
+	// Boolean recording if a measurement has been overwritten since the sketch was built, since numbers can't be taken out of it
+	bool sketchOutdated;
+	// Running summary of the values (Plus statistical errors), updated as measurements are added and found again if one is
+	// overwritten (String experiments leave it empty)
+	dataSummary runningSummary;
+	// Version of the measurements. This changes whenever measurements are overwritten or replaced, but not when they are added,
+	// and no two experiments ever have the same version. Results kept from the measurements can then check they are still valid
+	size_t version;
+	// Weighted sums of the last linear fit. This is only a record of earlier results, so it can be updated by const functions
+	mutable linearFitCache fitCache;
+
+	// Functions to add a value plus its systematic error to the sketch, and to build a sketch of all the columns, for either type
+	static void addToSketch(quantileSketch & sketch, const double & value, const double & systError) { sketch.add(value + systError); }
+	static void addToSketch(quantileSketch &, const string &, const string &) {}
+	static quantileSketch buildSketch(const measurementColumns<double> & columns) {
+		return (sketchData(columns.getValues().data(), columns.getSystErrors().data(), columns.size(), getSketchSize()));
+	}
+	static quantileSketch buildSketch(const measurementColumns<string> &) { return (quantileSketch{ getSketchSize() }); }
+	// Functions to add a value to the running summary, and to summarise all the columns, for either type of measurement
+	static void addToSummary(dataSummary & summary, const double & value, const double & systError) { summary.add(value + systError); }
+	static void addToSummary(dataSummary &, const string &, const string &) {}
+	static dataSummary summariseColumns(const measurementColumns<double> & columns) {
+		return (summariseData(columns.getValues().data(), columns.getSystErrors().data(), columns.size()));
+	}
+	static dataSummary summariseColumns(const measurementColumns<string> &) { return (emptySummary); }
 
 public:
 	// Default constructor
 	experiment();
 
-	// Paramatrised constructor
+	// Paramatrised constructor. Space is reserved for mc measurements and ec errors, which are then added with addMeasurement
 	experiment(const size_t mc, const size_t ec, const string tt);
 
-	// Copy constructor
+	// Copy constructor (Correlated experiments are not copied)
 	experiment(const experiment &exp);
 
 	// Move constructor
@@ -55,31 +134,75 @@ public:
 	experiment & operator=(experiment &&exp);
 
 	// Accesor functions (Most are self explanatory, simply giving access to the private variables)
-	size_t getMeasurementCounter() const { return(measurementCounter); }
+	size_t getMeasurementCounter() const { return(measurements.size()); }
 
-	measurement<V> & getMeasurement(const size_t & index);
+	measurement<V> getMeasurement(const size_t & index) const;
 
-	size_t getErrorCounter() const { return(errorCounter); }
+	size_t getErrorCounter() const { return(errorTimes.size()); }
 
-	measurement<string> & getMeasurementError(const size_t & index);
+	measurement<string> getMeasurementError(const size_t & index) const;
 
-	string getTitle() const { return(title); }
+	const measurementColumns<V> & getColumns() const { return (measurements); }
+
+	// Unit of the first measurement, used when printing results
+	const string & getUnit() const { return(measurements.getUnit(0)); }
+
+	const string & getTitle() const { return(title); }
 
 	void setTitle(const string & newTitle) { title = newTitle; }
 
-	vector<pair<string, size_t>> & getOrderVector() { return orderVector; }
+	const vector<bool> & getErrorOrder() const { return errorOrder; }
 
 	vector<experiment<double>*> & getNumericCorrelatedVector() { return (numericCorrelatedVector); }
+	const vector<experiment<double>*> & getNumericCorrelatedVector() const { return (numericCorrelatedVector); }
 
 	vector<experiment<string>*> & getStringCorrelatedVector() { return (stringCorrelatedVector); }
+	const vector<experiment<string>*> & getStringCorrelatedVector() const { return (stringCorrelatedVector); }
+
+	// Functions to add measurements and errors to the end of the experiment
+	void addMeasurement(const measurement<V> & mes);
+	void addMeasurement(const V & value, const V & error, const V & systError, string_view unit, const timestamp & time);
+	void addMeasurementError(const timestamp & time);
+
+	// Function to add the measurements and errors of exp to the end of this experiment, starting from measurement firstMeasurement
+	// and error firstError of exp, in the order they were input. Used for the measurements added since a journal was last saved
+	void appendFrom(const experiment<V> & exp, const size_t & firstMeasurement, const size_t & firstError);
+
+	// Function to overwrite an existing measurement
+	void setMeasurement(const size_t & index, const measurement<V> & mes);
+
+	// Function to make space for more measurements and errors without adding them
+	void reserve(const size_t mc, const size_t ec);
+
+	// Number of bytes used to store the measurements and errors of this experiment (Not including correlated experiments)
+	size_t getMemoryUsage() const;
+
+	// Function to bring the program wide counters in experimentAccounting up to date with this experiment
+	// Called after adding measurements, rather than once per measurement
+	void updateAccounting();
+
+	// Function to remove this experiment from the program wide counters, used for copies which aren't loaded data (eg. save snapshots)
+	// The counters stay as they are until updateAccounting is called again
+	void releaseAccounting();
 
 	// This returns the number of correlated experiments, not including the experiment itself
 	size_t getNumberOfCorrelated() const;
 
-	// Returns a string stream with the correctly formatted data for a save file
-	stringstream getSaveFileStream() const;
+	// Function to write the experiment and its correlated experiments to a text save file
+	// The data is written straight to the stream in small blocks, so no copy of the whole file is made
+	void writeSaveFile(ostream & output) const;
+
+	// Function to write the columns, error timestamps and order of input to a binary save file (Not including correlated experiments)
+	void writeBinaryData(binaryWriter & output) const;
+
+	// Function to replace the data of the experiment with mc measurements and ec errors read from a binary save file
+	// Returns false if the data isn't valid
+	bool readBinaryData(binaryReader & input, const size_t & mc, const size_t & ec);
 
 	// Data analysis functions
+	// Count, mean, variance, min and max of the measurements. These are kept up to date as measurements are added
+	dataSummary summary() const;
+
 	// Average
 	V getAverage() const;
 
@@ -89,15 +212,31 @@ public:
 	// Error on mean
 	V getErrorOnMean() const;
 
-	// Function to perform a linear fit. Returns vector of form (gradient, graidentError, intercept, interceptError, chiSq)
+	// Function to perform a linear fit. Returns vector of form (gradient, graidentError, intercept, interceptError, chiSq, reducedChiSq)
+	// The sums of the fit are kept, so fitting the same experiments again only has to look at the rows added since
 	vector<double> linearFit(const experiment<double> & depExp) const;
 
+	// Quantile sketch of the values plus systematic errors, built again first if a measurement was overwritten or the size of
+	// sketches has been changed
+	const quantileSketch & getSketch();
+
 	// Number of occurences of a word or number, and a percentage
-	vector<tuple<V, size_t, double>> countOccurrences() const;
+	// Words are ordered from most to least common and only the maxValues most common are returned
+	// Numbers are put in maxValues bins, given as <lower edge of bin, count, percentage>. The number of bins and the binning
+	// come from the settings if maxValues isn't given
+	vector<tuple<V, size_t, double>> countOccurrences(const size_t & maxValues = size_t(-1)) const;
+
+	// Histogram of the values of a numeric experiment, with its edges running from the smallest to the largest value
+	// The number of bins and the binning come from the settings if bins isn't given
+	histogram getDistribution(const size_t & bins = size_t(-1)) const;
 
 	// A function attempting to study any correlation between a number and a string outcome of an experiment
-	// Returns pair of <string value, corresponding average numeric value>
-	template <class T> vector<pair<string, double>> numericStringCorrelation( experiment<T> & exp);
+	// Returns pairs of <string value, summary of the corresponding numeric values>, in the order the strings were first found
+	template <class T> vector<pair<string, dataSummary>> numericStringCorrelation( experiment<T> & exp);
+
+	// Function to add the result of numericStringCorrelation to a report
+	static void reportStringCorrelation(stringstream & ss, const vector<pair<string, dataSummary>> & groups, const string & unit,
+		const int & indent);
 
 	// Function to generate a report for this experiment
 	stringstream makeReport(int indent);
@@ -109,75 +248,42 @@ public:
 
 // Default constructor
 template<class V> experiment<V>::experiment() :
-	measurementCounter{ 0 }, errorCounter{ 0 }, title{ "N/A" }, orderVector{} {
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter];
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
-}
+	title{ "N/A" }, accountedMeasurements{ 0 }, accountedErrors{ 0 }, accountedBytes{ 0 }, valueSketch{ getSketchSize() },
+	sketchOutdated{ false }, runningSummary{ emptySummary }, version{ experimentAccounting::newVersion() }, fitCache{} {}
 
 // Paramatrised constructor
-template<class V> experiment<V>::experiment(const size_t mc, const size_t ec, const string tt) {
-	measurementCounter = mc; errorCounter = ec; title = tt;
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter] ;
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
+template<class V> experiment<V>::experiment(const size_t mc, const size_t ec, const string tt) :
+	title{ tt }, accountedMeasurements{ 0 }, accountedErrors{ 0 }, accountedBytes{ 0 }, valueSketch{ getSketchSize() },
+	sketchOutdated{ false }, runningSummary{ emptySummary }, version{ experimentAccounting::newVersion() }, fitCache{} {
+	reserve(mc, ec);
+	updateAccounting();
 }
 
 // Copy constructor
-template<class V> experiment<V>::experiment(const experiment &exp) {
-	// copy data
-	measurementCounter = exp.measurementCounter; errorCounter = exp.errorCounter;
-	title = exp.title; orderVector = exp.orderVector;
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter];
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		measurements[i] = exp.measurements[i];
-	}
-	for (size_t i{ 0 }; i < errorCounter; i++) {
-		measurementErrors[i] = exp.measurementErrors[i];
-	}
+template<class V> experiment<V>::experiment(const experiment &exp) :
+	measurements{ exp.measurements }, errorTimes{ exp.errorTimes }, title{ exp.title }, errorOrder{ exp.errorOrder },
+	accountedMeasurements{ 0 }, accountedErrors{ 0 }, accountedBytes{ 0 }, valueSketch{ exp.valueSketch },
+	sketchOutdated{ exp.sketchOutdated }, runningSummary{ exp.runningSummary }, version{ experimentAccounting::newVersion() },
+	fitCache{} {
+	updateAccounting();
 }
 
 // Move constructor
-template<class V> experiment<V>::experiment(experiment &&exp) {
-	// copy data
-	measurementCounter = exp.measurementCounter; errorCounter = exp.errorCounter;
-	title = exp.title; orderVector = exp.orderVector;
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter];
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		measurements[i] = exp.measurements[i];
-	}
-	for (size_t i{ 0 }; i < errorCounter; i++) {
-		measurementErrors[i] = exp.measurementErrors[i];
-	}
-	// Delete exp data
-	exp.measurementCounter = 0; exp.errorCounter = 0; exp.title = "N/A";
-	measurements = NULL; measurementErrors = NULL; exp.orderVector.clear();
+template<class V> experiment<V>::experiment(experiment &&exp) :
+	measurements{ move(exp.measurements) }, errorTimes{ move(exp.errorTimes) }, title{ exp.title }, errorOrder{ move(exp.errorOrder) },
+	numericCorrelatedVector{ move(exp.numericCorrelatedVector) }, stringCorrelatedVector{ move(exp.stringCorrelatedVector) },
+	accountedMeasurements{ exp.accountedMeasurements }, accountedErrors{ exp.accountedErrors }, accountedBytes{ exp.accountedBytes },
+	valueSketch{ move(exp.valueSketch) }, sketchOutdated{ exp.sketchOutdated }, runningSummary{ exp.runningSummary },
+	version{ exp.version }, fitCache{ exp.fitCache } {
+	// Storage and correlated experiments now belong to this experiment
+	exp.measurements = measurementColumns<V>{}; exp.errorTimes.clear(); exp.title = "N/A"; exp.errorOrder.clear();
+	exp.valueSketch.clear(); exp.sketchOutdated = false; exp.runningSummary = emptySummary;
+	exp.version = experimentAccounting::newVersion(); exp.fitCache = linearFitCache{};
+	exp.numericCorrelatedVector.clear(); exp.stringCorrelatedVector.clear();
+	exp.accountedMeasurements = 0; exp.accountedErrors = 0; exp.accountedBytes = 0;
 }
 
+// Destructor
 template<class V> experiment<V>::~experiment() {
 	for (size_t i{ 0 }; i < numericCorrelatedVector.size(); i++) {
 		delete numericCorrelatedVector[i];
@@ -185,28 +291,19 @@ template<class V> experiment<V>::~experiment() {
 	for (size_t i{ 0 }; i < stringCorrelatedVector.size(); i++) {
 		delete stringCorrelatedVector[i];
 	}
-	delete[] measurements; delete[] measurementErrors;
+	experimentAccounting::removeStorage(accountedMeasurements, accountedErrors, accountedBytes);
 }
 
 // Copy assignment operator
 template<class V> experiment<V> & experiment<V>::operator=(const experiment &exp) {
 	// Check for self assignment
 	if (&exp == this) { return(*this); }
-	// Delete data in arrays
-	delete[] measurements; delete[] measurementErrors;
 	// copy data
-	measurementCounter = exp.measurementCounter; errorCounter = exp.errorCounter;
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter];
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
-	title = exp.title; orderVector = exp.orderVector;
-	for (size_t i{ 0 }; i < measurementCounter; i++) { measurements[i] = exp.measurements[i]; }
-	for (size_t i{ 0 }; i < errorCounter; i++) { measurementErrors[i] = exp.measurementErrors[i]; }
+	measurements = exp.measurements; errorTimes = exp.errorTimes;
+	title = exp.title; errorOrder = exp.errorOrder;
+	valueSketch = exp.valueSketch; sketchOutdated = exp.sketchOutdated; runningSummary = exp.runningSummary;
+	version = experimentAccounting::newVersion();
+	updateAccounting();
 	return (*this);
 }
 
@@ -214,49 +311,130 @@ template<class V> experiment<V> & experiment<V>::operator=(const experiment &exp
 template<class V> experiment<V> & experiment<V>::operator=(experiment &&exp) {
 	// Check for self assignment
 	if (&exp == this) { return(*this); }
-	// Delete data in arrays
-	delete[] measurements; delete[] measurementErrors;
-	// copy data
-	measurementCounter = exp.measurementCounter; errorCounter = exp.errorCounter;
-	try {
-		measurements = new measurement<V>[measurementCounter];
-		measurementErrors = new measurement<string>[errorCounter];
-	}
-	catch (bad_alloc) {
-		cout << "Warning: Error when allocating memory in experiment class. Exiting program" << endl;
-		exit(1);
-	}
-	title = exp.title; orderVector = exp.orderVector;
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		measurements[i] = exp.measurements[i];
-	}
-	for (size_t i{ 0 }; i < errorCounter; i++) {
-		measurementErrors[i] = exp.measurementErrors[i];
-	}
+	// Move data
+	measurements = move(exp.measurements); errorTimes = move(exp.errorTimes);
+	title = exp.title; errorOrder = move(exp.errorOrder);
+	valueSketch = move(exp.valueSketch); sketchOutdated = exp.sketchOutdated; runningSummary = exp.runningSummary;
+	version = exp.version; fitCache = exp.fitCache;
+	// The correlated experiments of this experiment are replaced by those of exp, as in the move constructor
+	for (size_t i{ 0 }; i < numericCorrelatedVector.size(); i++) { delete numericCorrelatedVector[i]; }
+	for (size_t i{ 0 }; i < stringCorrelatedVector.size(); i++) { delete stringCorrelatedVector[i]; }
+	numericCorrelatedVector = move(exp.numericCorrelatedVector); stringCorrelatedVector = move(exp.stringCorrelatedVector);
 	// Delete exp data
-	exp.measurementCounter = 0; exp.errorCounter = 0; exp.title = "N/A";
-	measurements = NULL; measurementErrors = NULL; exp.orderVector.clear();
+	exp.measurements = measurementColumns<V>{}; exp.errorTimes.clear(); exp.title = "N/A"; exp.errorOrder.clear();
+	exp.valueSketch.clear(); exp.sketchOutdated = false; exp.runningSummary = emptySummary;
+	exp.version = experimentAccounting::newVersion(); exp.fitCache = linearFitCache{};
+	exp.numericCorrelatedVector.clear(); exp.stringCorrelatedVector.clear();
+	updateAccounting(); exp.updateAccounting();
 	return (*this);
 }
 
 // Accesor function for accesing a particular measurement
-template<class V> measurement<V> & experiment<V>::getMeasurement(const size_t & index) {
-	if (index < measurementCounter) { return (measurements[index]); }
+template<class V> measurement<V> experiment<V>::getMeasurement(const size_t & index) const {
+	if (index < measurements.size()) { return (measurements.get(index)); }
 	else {
 		cout << "Warning: Attempt to access out of range index: " << index;
-		cout << " > " << measurementCounter << endl; exit(1);
+		cout << " > " << measurements.size() << endl; exit(1);
 	}
 }
 
 // Accesor function for accesing a particular error measurement
-template<class V> measurement<string> & experiment<V>::getMeasurementError(const size_t & index) {
-	if (index < errorCounter) { return (measurementErrors[index]); }
+template<class V> measurement<string> experiment<V>::getMeasurementError(const size_t & index) const {
+	if (index < errorTimes.size()) { return (measurement<string>{ "error", "N/A", "N/A", "N/A", errorTimes[index] }); }
 	else {
 		cout << "Warning: Attempt to access out of range index: " << index;
-		cout << " > " << errorCounter << endl; exit(1);
+		cout << " > " << errorTimes.size() << endl; exit(1);
 	}
 }
 
+// Function to add a measurement to the end of the experiment
+template<class V> void experiment<V>::addMeasurement(const measurement<V> & mes) {
+	measurements.push_back(mes);
+	errorOrder.push_back(false);
+	addToSketch(valueSketch, mes.getValue(), mes.getSystError());
+	addToSummary(runningSummary, mes.getValue(), mes.getSystError());
+}
+
+// Function to add a measurement to the end of the experiment from its parts
+template<class V> void experiment<V>::addMeasurement(const V & value, const V & error, const V & systError,
+	string_view unit, const timestamp & time) {
+	measurements.push_back(value, error, systError, unit, time);
+	errorOrder.push_back(false);
+	addToSketch(valueSketch, value, systError);
+	addToSummary(runningSummary, value, systError);
+}
+
+// Function to add an error to the end of the experiment
+template<class V> void experiment<V>::addMeasurementError(const timestamp & time) {
+	errorTimes.push_back(time);
+	errorOrder.push_back(true);
+}
+
+// Function to add the measurements and errors of exp to the end of this experiment, starting from measurement firstMeasurement
+// and error firstError of exp. This assumes the first firstMeasurement + firstError entries of exp were input before the rest
+template<class V> void experiment<V>::appendFrom(const experiment<V> & exp, const size_t & firstMeasurement, const size_t & firstError) {
+	const measurementColumns<V> & columns{ exp.measurements };
+	size_t measurementIndex{ firstMeasurement }, errorIndex{ firstError };
+	reserve(exp.getMeasurementCounter() - firstMeasurement, exp.getErrorCounter() - firstError);
+	for (size_t i{ firstMeasurement + firstError }; i < exp.errorOrder.size(); i++) {
+		if (!exp.errorOrder[i]) {
+			addMeasurement(columns.getValues()[measurementIndex], columns.getErrors()[measurementIndex],
+				columns.getSystErrors()[measurementIndex], columns.getUnit(measurementIndex), columns.getTimes()[measurementIndex]);
+			measurementIndex++;
+		}
+		else {
+			addMeasurementError(exp.errorTimes[errorIndex]);
+			errorIndex++;
+		}
+	}
+}
+
+// Function to overwrite an existing measurement
+template<class V> void experiment<V>::setMeasurement(const size_t & index, const measurement<V> & mes) {
+	if (index < measurements.size()) {
+		// Values can't be taken out of the running summary, so it is found again. The sketch is only built again when it is used
+		measurements.set(index, mes);
+		runningSummary = summariseColumns(measurements);
+		sketchOutdated = true;
+		version = experimentAccounting::newVersion();
+	}
+	else {
+		cout << "Warning: Attempt to access out of range index: " << index;
+		cout << " > " << measurements.size() << endl; exit(1);
+	}
+}
+
+// Function to make space for more measurements and errors without adding them
+// Space at least doubles when it grows, so adding a few measurements at a time (eg. from a live feed or journal) stays cheap
+template<class V> void experiment<V>::reserve(const size_t mc, const size_t ec) {
+	if (measurements.size() + mc > measurements.capacity()) {
+		measurements.reserve(max(measurements.size() + mc, 2 * measurements.capacity()));
+	}
+	if (errorTimes.size() + ec > errorTimes.capacity()) { errorTimes.reserve(max(errorTimes.size() + ec, 2 * errorTimes.capacity())); }
+	if (errorOrder.size() + mc + ec > errorOrder.capacity()) {
+		errorOrder.reserve(max(errorOrder.size() + mc + ec, 2 * errorOrder.capacity()));
+	}
+}
+
+// Number of bytes used to store the measurements and errors of this experiment
+template<class V> size_t experiment<V>::getMemoryUsage() const {
+	return (measurements.getMemoryUsage() + errorTimes.capacity() * sizeof(timestamp) + errorOrder.capacity() / 8
+		+ valueSketch.getMemoryUsage());
+}
+
+// Function to bring the program wide counters in experimentAccounting up to date with this experiment
+template<class V> void experiment<V>::updateAccounting() {
+	experimentAccounting::removeStorage(accountedMeasurements, accountedErrors, accountedBytes);
+	accountedMeasurements = getMeasurementCounter(); accountedErrors = getErrorCounter(); accountedBytes = getMemoryUsage();
+	experimentAccounting::addStorage(accountedMeasurements, accountedErrors, accountedBytes);
+}
+
+// Function to remove this experiment from the program wide counters
+template<class V> void experiment<V>::releaseAccounting() {
+	experimentAccounting::removeStorage(accountedMeasurements, accountedErrors, accountedBytes);
+	accountedMeasurements = 0; accountedErrors = 0; accountedBytes = 0;
+}
+
 // Accesor function returning total number of correlated measurements
 template<class V> size_t experiment<V>::getNumberOfCorrelated() const {
 	size_t output{ 0 };
@@ -274,71 +452,90 @@ template<class V> size_t experiment<V>::getNumberOfCorrelated() const {
 	return output;
 }
 
-// Accesor function that returns a string stream with all save data information correctly formatted
-template<class V> stringstream experiment<V>::getSaveFileStream() const {
-	stringstream ss;
-	ss << "NUMERIC_EXPERIMENT_BEGIN" << endl;
-	ss << title << ", " << measurementCounter << ", " << errorCounter << endl;
-	for (size_t i{ 0 }; i < orderVector.size(); i++) {
-		if (get<0>(orderVector[i]) == "numeric") {
-			// Numeric measurement
-			ss << measurements[get<1>(orderVector[i])] << endl;
+// Function to write the experiment to a text save file, followed by its correlated experiments
+// Lines are collected in a block of at most saveBlockSize characters, which is written to the stream whenever it is full
+template<class V> void experiment<V>::writeSaveFile(ostream & output) const {
+	const size_t saveBlockSize{ 1 << 16 };
+	const bool isString{ is_same<V, string>::value };
+	string block;
+	block.reserve(saveBlockSize + 256);
+	block += isString ? "STRING_EXPERIMENT_BEGIN\n" : "NUMERIC_EXPERIMENT_BEGIN\n";
+	block += title; block += ", "; appendToString(block, getMeasurementCounter());
+	block += ", "; appendToString(block, getErrorCounter()); block += '\n';
+	const typename measurementColumns<V>::column & values{ measurements.getValues() }, & errors{ measurements.getErrors() };
+	const typename measurementColumns<V>::column & systErrors{ measurements.getSystErrors() };
+	const vector<timestamp> & times{ measurements.getTimes() };
+	size_t measurementIndex{ 0 }, errorIndex{ 0 };
+	for (size_t i{ 0 }; i < errorOrder.size(); i++) {
+		if (!errorOrder[i]) {
+			// Valid measurement, in the same format as the << operator of measurement
+			appendToString(block, values[measurementIndex]); block += ", ";
+			appendToString(block, errors[measurementIndex]); block += ", ";
+			appendToString(block, systErrors[measurementIndex]); block += ", ";
+			block += measurements.getUnit(measurementIndex); block += ", ";
+			times[measurementIndex].appendTimeString(block); block += '\n';
+			measurementIndex++;
 		}
 		else {
 			// Error measurement
-			ss << measurementErrors[get<1>(orderVector[i])] << endl;
+			block += "error, N/A, N/A, N/A, ";
+			errorTimes[errorIndex].appendTimeString(block); block += '\n';
+			errorIndex++;
 		}
+		if (block.size() >= saveBlockSize) { output.write(block.data(), streamsize(block.size())); block.clear(); }
 	}
-	ss << "NUMERIC_EXPERIMENT_END" << endl;
+	block += isString ? "STRING_EXPERIMENT_END\n" : "NUMERIC_EXPERIMENT_END\n";
+	output.write(block.data(), streamsize(block.size()));
 
+	// Numeric experiments leave an empty line after each correlated experiment
 	for (size_t i{ 0 }; i < numericCorrelatedVector.size(); i++) {
-		ss << numericCorrelatedVector[i]->getSaveFileStream().str() << endl;
-		ss << "correlate, " << title << ", " << numericCorrelatedVector[i]->getTitle() << endl;
+		numericCorrelatedVector[i]->writeSaveFile(output);
+		if (!isString) { output << '\n'; }
+		output << "correlate, " << title << ", " << numericCorrelatedVector[i]->getTitle() << '\n';
 	}
 	for (size_t i{ 0 }; i < stringCorrelatedVector.size(); i++) {
-		ss << stringCorrelatedVector[i]->getSaveFileStream().str() << endl;
-		ss << "correlate, " << title << ", " << stringCorrelatedVector[i]->getTitle() << endl;
+		stringCorrelatedVector[i]->writeSaveFile(output);
+		if (!isString) { output << '\n'; }
+		output << "correlate, " << title << ", " << stringCorrelatedVector[i]->getTitle() << '\n';
 	}
-	return ss;
 }
 
-template<> stringstream experiment<string>::getSaveFileStream() const {
-	stringstream ss;
-	ss << "STRING_EXPERIMENT_BEGIN" << endl;
-	ss << title << ", " << measurementCounter << ", " << errorCounter << endl;
-	for (size_t i{ 0 }; i < orderVector.size(); i++) {
-		if (get<0>(orderVector[i]) == "string") {
-			// String measurement
-			ss << measurements[get<1>(orderVector[i])] << endl;
-		}
-		else {
-			// Error measurement
-			ss << measurementErrors[get<1>(orderVector[i])] << endl;
-		}
-	}
-	ss << "STRING_EXPERIMENT_END" << endl;
-
-	for (size_t i{ 0 }; i < numericCorrelatedVector.size(); i++) {
-		ss << numericCorrelatedVector[i]->getSaveFileStream().str();
-		ss << "correlate, " << title << ", " << numericCorrelatedVector[i]->getTitle() << endl;
-	}
-	for (size_t i{ 0 }; i < stringCorrelatedVector.size(); i++) {
-		ss << stringCorrelatedVector[i]->getSaveFileStream().str();
-		ss << "correlate, " << title << ", " << stringCorrelatedVector[i]->getTitle() << endl;
-	}
-	return ss;
+// Function to write the columns, error timestamps and order of input to a binary save file
+template<class V> void experiment<V>::writeBinaryData(binaryWriter & output) const {
+	measurements.writeBinary(output);
+	output.writeColumn(errorTimes);
+	output.writeBitmap(errorOrder);
 }
 
+// Function to replace the data of the experiment with data read from a binary save file
+template<class V> bool experiment<V>::readBinaryData(binaryReader & input, const size_t & mc, const size_t & ec) {
+	if (mc + ec < mc || !measurements.readBinary(input, mc) || !input.readColumn(errorTimes, ec)
+		|| !input.readBitmap(errorOrder, mc + ec)) { return (false); }
+	// The whole column is read at once, so the summary and sketch are found from it on the statistics threads
+	valueSketch = buildSketch(measurements);
+	sketchOutdated = false;
+	runningSummary = summariseColumns(measurements);
+	version = experimentAccounting::newVersion();
+	// The order of input must contain exactly ec errors
+	return (size_t(count(errorOrder.begin(), errorOrder.end(), true)) == ec);
+}
 
 // Data analysis functions
+// Summary (Count, mean, variance, min and max)
+// Numeric
+template <class V> dataSummary experiment<V>::summary() const {
+	return (runningSummary);
+}
+// String
+template <> dataSummary experiment<string>::summary() const {
+	cout << "Warning: Experiments of type 'string' have no 'summary()' function. Exiting program." << endl;
+	exit(1);
+}
+
 // Average
 // Numeric
 template <class V> V experiment<V>::getAverage() const {
-	double returnValue{ 0 };
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		returnValue += measurements[i].getValue() + measurements[i].getSystError();
-	}
-	return (returnValue / measurementCounter);
+	return (summary().mean);
 }
 // String
 template <> string experiment<string>::getAverage() const {
@@ -349,14 +546,7 @@ template <> string experiment<string>::getAverage() const {
 // Standard deviation
 // Numeric
 template <class V> V experiment<V>::getStandardDeviation() const {
-	double returnValue{ 0 };
-	double average{ this->getAverage() };
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		returnValue += pow(measurements[i].getValue() + measurements[i].getSystError() - average, 2);
-	}
-	returnValue /= measurementCounter - 1;
-	returnValue = sqrt(returnValue);
-	return(returnValue);
+	return (summary().getStandardDeviation());
 }
 // String
 template <> string experiment<string>::getStandardDeviation() const {
@@ -367,9 +557,7 @@ template <> string experiment<string>::getStandardDeviation() const {
 // Error on mean
 // Numeric
 template <class V> V experiment<V>::getErrorOnMean() const {
-	double returnValue{ this->getStandardDeviation() };
-	returnValue /= sqrt(measurementCounter);
-	return(returnValue);
+	return (summary().getErrorOnMean());
 }
 // String
 template <> string experiment<string>::getErrorOnMean() const {
@@ -377,58 +565,98 @@ template <> string experiment<string>::getErrorOnMean() const {
 	exit(1);
 }
 
+// Quantile sketch of the values, built again first if it is out of date
+template <class V> const quantileSketch & experiment<V>::getSketch() {
+	if (sketchOutdated || valueSketch.getMaxSize() != max(getSketchSize(), size_t(8))) {
+		valueSketch = buildSketch(measurements);
+		sketchOutdated = false;
+	}
+	return (valueSketch);
+}
+
 // Function to perform a linear fit. Returns vector of form (gradient, graidentError, intercept, interceptError, chiSq)
 template<> vector<double> experiment<double>::linearFit(const experiment<double>& depExp) const {
 	vector<double> xValues, yValues, yWeights;
-	double sumW{ 0 }, sumWX{ 0 }, sumWXX{ 0 }, sumWY{ 0 }, sumWXY{ 0 };
-	int validEntries{ 0 };
 	vector<double> output;
 
-	// Collect data in vectors and apply standard formulas
-	for (size_t i{ 0 }; i < orderVector.size(); i++) {
-		if (get<0>(orderVector[i]) == "numeric" && get<0>(depExp.orderVector[i]) == "numeric") {
+	// Start again if the last fit was with another experiment, or measurements of either experiment have been changed since
+	if (fitCache.version != version || fitCache.depVersion != depExp.version) {
+		fitCache = linearFitCache{ version, depExp.version, 0, 0, 0, 0, 0, 0, weightedSums{ 0, 0, 0, 0, 0 }, false, 0, 0, 0 };
+	}
+
+	// Collect the rows input since the last fit in vectors, then add their sums to the kept sums
+	// Rows are matched by input order, skipping any row which is an error in either experiment
+	const vector<double> & values{ measurements.getValues() }, & systErrors{ measurements.getSystErrors() };
+	const vector<double> & depValues{ depExp.measurements.getValues() }, & depErrors{ depExp.measurements.getErrors() };
+	const vector<double> & depSystErrors{ depExp.measurements.getSystErrors() };
+	size_t index{ fitCache.index }, depIndex{ fitCache.depIndex }, row{ fitCache.rows };
+	for (; row < errorOrder.size() && row < depExp.errorOrder.size(); row++) {
+		if (!errorOrder[row] && !depExp.errorOrder[row]) {
 			// Check for error of 0
-			if (depExp.measurements[get<1>(orderVector[i])].getError() == 0) {
+			if (depErrors[depIndex] == 0) {
 				cout << "Warning: Attempted a linear fit with an error of 0. Exiting program" << endl;
 				exit(1);
 			}
-			xValues.push_back(measurements[get<1>(orderVector[i])].getValue() + measurements[get<1>(orderVector[i])].getSystError());
-			yValues.push_back(depExp.measurements[get<1>(depExp.orderVector[i])].getValue() 
-				+ depExp.measurements[get<1>(depExp.orderVector[i])].getSystError());
-			yWeights.push_back(1/(pow(depExp.measurements[get<1>(depExp.orderVector[i])].getError(), 2)));
-			sumW += yWeights.back();
-			sumWX += yWeights.back() * xValues.back();
-			sumWXX += yWeights.back() * pow(xValues.back(), 2);
-			sumWY += yWeights.back() * yValues.back();
-			sumWXY += yWeights.back() * xValues.back() * yValues.back();
-			validEntries++;
+			if (fitCache.entries == 0 && xValues.empty()) {
+				fitCache.xShift = values[index] + systErrors[index];
+				fitCache.yShift = depValues[depIndex] + depSystErrors[depIndex];
+			}
+			xValues.push_back(values[index] + systErrors[index] - fitCache.xShift);
+			yValues.push_back(depValues[depIndex] + depSystErrors[depIndex] - fitCache.yShift);
+			yWeights.push_back(1 / (depErrors[depIndex] * depErrors[depIndex]));
 		}
+		if (!errorOrder[row]) { index++; }
+		if (!depExp.errorOrder[row]) { depIndex++; }
 	}
-	
+	// Find the weighted sums of the new rows (Shared between threads for large experiments)
+	weightedSums newSums{ summariseWeightedData(xValues.data(), yValues.data(), yWeights.data(), xValues.size()) };
+	weightedSums & sums{ fitCache.sums };
+	sums.sumW += newSums.sumW; sums.sumWX += newSums.sumWX; sums.sumWXX += newSums.sumWXX;
+	sums.sumWY += newSums.sumWY; sums.sumWXY += newSums.sumWXY;
+	fitCache.rows = row; fitCache.index = index; fitCache.depIndex = depIndex;
+	fitCache.entries += xValues.size();
+
+	size_t validEntries{ fitCache.entries };
+
 	// Check for a minnmum of 3 measurements
 	if (validEntries < 3) {
 		cout << "Warning: Linear fit could not be performed with less than 3 valid measurements." << endl;
+		// The first fit needs the residuals of every row, so the rows read so far are read again next time
+		fitCache = linearFitCache{};
 		return(vector<double>{0});
 	}
+	double sumW{ sums.sumW }, sumWX{ sums.sumWX }, sumWXX{ sums.sumWXX }, sumWY{ sums.sumWY }, sumWXY{ sums.sumWXY };
+	double xShift{ fitCache.xShift }, yShift{ fitCache.yShift };
 
-	// Calculate relevant quantities
+	// Calculate relevant quantities. The gradient and its error are the same for shifted values, while the intercept is
+	// shifted back, and its error needs the sum of w * x^2 without the shift
 	double denom{ (sumW*sumWXX) - pow(sumWX, 2) };
 	double gradient{ ((sumW*sumWXY) - (sumWX*sumWY)) / denom };
 	output.push_back(gradient);
 	double gradientError{ sqrt(sumW / denom) };
 	output.push_back(gradientError);
-	double intercept{ ((sumWY*sumWXX) - (sumWX*sumWXY)) / denom };
-	output.push_back(intercept);
-	double interceptError{ sqrt(sumWXX / denom) };
+	double shiftedIntercept{ ((sumWY*sumWXX) - (sumWX*sumWXY)) / denom };
+	output.push_back(shiftedIntercept + yShift - gradient * xShift);
+	double interceptError{ sqrt((sumWXX + 2 * xShift * sumWX + xShift * xShift * sumW) / denom) };
 	output.push_back(interceptError);
 
-	double chiSq{ 0 };
-
-	// Find the chiSq value
-	for (size_t i{ 0 }; i < orderVector.size(); i++) {
-		double residual = gradient*xValues[i] + intercept - yValues[i];
-		chiSq += yWeights[i] * pow(residual, 2);
+	// Find the chiSq value, the sum of w * (y - gradient * x - intercept)^2. The first fit sums the residuals of every row
+	// Later fits only sum the residuals of the new rows from the last fit. With r the residuals from the last fit, the older rows
+	// are already in the last chiSq and have sums of w * r * x and w * r of 0, so the new chiSq is
+	// last chiSq + sum of w * r^2 - (change in gradient) * (sum of w * r * x) - (change in intercept) * (sum of w * r)
+	// Every term is about the size of the residuals, so no precision is lost taking away large numbers
+	double chiSq;
+	if (!fitCache.fitted) {
+		chiSq = summariseResiduals(xValues.data(), yValues.data(), yWeights.data(), xValues.size(), gradient, shiftedIntercept).sumWRR;
 	}
+	else {
+		residualSums newResiduals{ summariseResiduals(xValues.data(), yValues.data(), yWeights.data(), xValues.size(), fitCache.gradient,
+			fitCache.intercept) };
+		chiSq = fitCache.chiSq + newResiduals.sumWRR - (gradient - fitCache.gradient) * newResiduals.sumWRX
+			- (shiftedIntercept - fitCache.intercept) * newResiduals.sumWR;
+	}
+	fitCache.fitted = true;
+	fitCache.gradient = gradient; fitCache.intercept = shiftedIntercept; fitCache.chiSq = chiSq;
 	output.push_back(chiSq);
 
 	double reducedChiSq{ chiSq / double(validEntries - 2) };
@@ -445,104 +673,102 @@ template<> vector<double> experiment<string>::linearFit(const experiment<double>
 
 
 // Count number of occurences of a word
-template<> vector<tuple<string, size_t, double>> experiment<string>::countOccurrences() const {
+// Words are stored as ids in the table of the value column, so every measurement is counted by its id without comparing strings
+template<> vector<tuple<string, size_t, double>> experiment<string>::countOccurrences(const size_t & maxValues) const {
 	vector<tuple<string, size_t, double>> output;
-	// Loop through all experiments
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		bool foundValue{ false };
-		// Loop through values already encountered
-		for (size_t j{ 0 }; j < output.size(); j++) {
-			if (this->measurements[i].getValue() == get<0>(output[j])) {
-				// Found value
-				foundValue = true;
-				get<1>(output[j])++;
-				get<2>(output[j]) += 100 / double(measurementCounter);
-			}
-		}
-		if (!foundValue) {
-			// Not found value, create instance in output vector
-			output.push_back(tuple<string, size_t, double>{this->measurements[i].getValue(), 1, 100 / double(measurementCounter)});
-		}
-	}
-
-	// Before returning list, make sure it is ordered from most to least common
-	vector<tuple<string, size_t, double>>::iterator vecBegin{ output.begin() }, vecEnd{ output.end() };
-	sort(vecBegin, vecEnd,
-		[](tuple<string, size_t, double> tupA, tuple<string, size_t, double> tupB) {
-		return(get<2>(tupA) > get<2>(tupB));
+	const stringColumn & values{ measurements.getValues() };
+	const stringTable & words{ values.getTable() };
+	size_t measurementCounter{ values.size() };
+	vector<size_t> counts(words.size(), 0);
+	for (size_t i{ 0 }; i < measurementCounter; i++) { counts[values.getCode(i)]++; }
+
+	// Order the ids from most to least common, with the word found first coming first when they are equally common
+	// Only the part of the list being returned needs to be sorted. The table can hold words which are no longer used
+	vector<uint32_t> order;
+	for (size_t i{ 0 }; i < counts.size(); i++) {
+		if (counts[i] != 0) { order.push_back(uint32_t(i)); }
+	}
+	size_t outputSize{ min(maxValues, order.size()) };
+	partial_sort(order.begin(), order.begin() + outputSize, order.end(), [&counts](const uint32_t & a, const uint32_t & b) {
+		return (counts[a] > counts[b] || (counts[a] == counts[b] && a < b));
 	});
 
+	// Percentages are found from the exact counts once counting is finished
+	output.reserve(outputSize);
+	for (size_t i{ 0 }; i < outputSize; i++) {
+		output.push_back(tuple<string, size_t, double>{ words.getString(order[i]), counts[order[i]],
+			100 * double(counts[order[i]]) / double(measurementCounter) });
+	}
 	return (output);
 }
-// Number of occurences of numbers by dividing data into bins
-template<> vector<tuple<double, size_t, double>> experiment<double>::countOccurrences() const {
-	vector<tuple<double, size_t, double>> output;
-	double binSize;
-	vector<double> values;
-	// Loop through all experiments
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		values.push_back(measurements[i].getValue());
-	}
-	
-	// Sort by value
-	sort(values.begin(), values.end());
-
-	// Find binsize (max-min)/10
-	binSize = (values.back() - values[0]) / 10;
 
-	// Create bins
-	for (size_t i{ 0 }; i < 10; i++) {
-		output.push_back(tuple<double, size_t, double>{values[0] + i*binSize, 0, 0});
+// Histogram of the values
+template<> histogram experiment<double>::getDistribution(const size_t & bins) const {
+	// Fill the bins straight from the values, without copying or sorting them
+	histogram output{ makeHistogram(measurements.getValues().data(), measurements.size(), bins != size_t(-1) ? bins : getHistogramBins(),
+		getHistogramBinning()) };
+	if (output.binning != getHistogramBinning()) {
+		cout << "Warning: Experiment '" << title << "' has values which aren't positive, so " << getBinningName(output.binning)
+			<< " bins are used instead of " << getBinningName(getHistogramBinning()) << " bins." << endl;
 	}
+	return (output);
+}
+// For strings
+template<> histogram experiment<string>::getDistribution(const size_t &) const {
+	cout << "Warning: Experiments of type 'string' have no 'getDistribution()' function. Exiting program." << endl;
+	exit(1);
+}
 
-	// Fill entries of output
-	int counter{ 1 };
-	for (size_t i{ 0 }; i < values.size(); i++) {
-		if (values[i] > (values[0] + binSize*counter)) { counter++;}
-		get<1>(output[counter - 1]) += 1;
-		get<2>(output[counter - 1]) += 100 / double(measurementCounter);
+// Number of occurences of numbers by dividing data into bins
+template<> vector<tuple<double, size_t, double>> experiment<double>::countOccurrences(const size_t & maxValues) const {
+	vector<tuple<double, size_t, double>> output;
+	size_t measurementCounter{ measurements.size() };
+	histogram distribution{ getDistribution(maxValues) };
+	for (size_t i{ 0 }; i < distribution.counts.size(); i++) {
+		output.push_back(tuple<double, size_t, double>{ distribution.edges[i], distribution.counts[i],
+			100 * double(distribution.counts[i]) / double(measurementCounter) });
 	}
-
 	return (output);
 }
 
 // A function attempting to study any correlation between a number and a string outcome of an experiment
-// Returns pair of <string value, corresponding average numeric value>
-template<> template<> vector<pair<string, double>> experiment<double>::numericStringCorrelation(experiment<string>& exp) {
-	vector<pair<string, double>> output;
-	vector<int> entries;
-
-	// For each type of string, find the average numeric outcome
-	for (size_t i{ 0 }; i < measurementCounter; i++) {
-		bool stringFound{ false };
-		for (size_t j{ 0 }; j < output.size(); j++) {
-			if (exp.getMeasurement(i).getValue() == get<0>(output[j])) {
-				// Measure one more count for this string
-				stringFound = true;
-				get<1>(output[j]) += measurements[i].getValue() + measurements[i].getSystError();
-				entries[j]++;
-			}
-		}
-		if (!stringFound) {
-			// Create entry for this string
-			output.push_back(pair<string, double>{exp.getMeasurement(i).getValue(), measurements[i].getValue() + measurements[i].getSystError()});
-			entries.push_back(1);
-		}
+// The numeric values are grouped by the id of the string in the string column, so every group is summarised in one pass
+template<> template<> vector<pair<string, dataSummary>> experiment<double>::numericStringCorrelation(experiment<string>& exp) {
+	vector<pair<string, dataSummary>> output;
+	const vector<double> & values{ measurements.getValues() }, & systErrors{ measurements.getSystErrors() };
+	const stringColumn & strings{ exp.getColumns().getValues() };
+	// Only measurements found in both experiments are used
+	size_t count{ min(values.size(), strings.size()) };
+	vector<dataSummary> groups{ summariseGroups(values.data(), systErrors.data(), strings.getCodes(), count,
+		strings.getTable().size()) };
+
+	// Ids are given in the order the strings were first found. The table can hold strings which are no longer used
+	for (size_t i{ 0 }; i < groups.size(); i++) {
+		if (groups[i].count != 0) { output.push_back(pair<string, dataSummary>{ strings.getTable().getString(uint32_t(i)), groups[i] }); }
 	}
-
-	// Divide by entries to get the average
-	for (size_t i{ 0 }; i < entries.size(); i++) {
-		get<1>(output[i]) /= entries[i];
-	}
-
 	return (output);
 }
 // For strings call function the other way around
-template<> template<> vector<pair<string, double>> experiment<string>::numericStringCorrelation(experiment<double>& exp) {
-	vector<pair<string, double>> output{ exp.numericStringCorrelation(*this) };
+template<> template<> vector<pair<string, dataSummary>> experiment<string>::numericStringCorrelation(experiment<double>& exp) {
+	vector<pair<string, dataSummary>> output{ exp.numericStringCorrelation(*this) };
 	return (output);
 }
 
+// Function to add the result of numericStringCorrelation to a report
+template<class V> void experiment<V>::reportStringCorrelation(stringstream & ss, const vector<pair<string, dataSummary>> & groups,
+	const string & unit, const int & indent) {
+	ss << string(5 * indent - 5, ' ') << "The numeric values corresponding to each string outcome are the following:" << endl;
+	for (size_t i{ 0 }; i < groups.size(); i++) {
+		const dataSummary & group{ get<1>(groups[i]) };
+		ss << string(5 * indent - 5, ' ') << get<0>(groups[i]) << ": " << group.mean;
+		// The spread of a single value isn't defined
+		if (group.count > 1) { ss << "+/-" << group.getErrorOnMean(); }
+		ss << " " << unit << " (" << group.count << (group.count == 1 ? " entry" : " entries");
+		if (group.count > 1) { ss << ", standard deviation " << group.getStandardDeviation() << ", from " << group.min << " to " << group.max; }
+		ss << ")" << endl;
+	}
+}
+
 // Report function
 // For numeric experiments
 template<class V> stringstream experiment<V>::makeReport(int indent) {
@@ -556,18 +782,28 @@ template<class V> stringstream experiment<V>::makeReport(int indent) {
 	}
 	ss << string(5 * indent, ' ') << "Experiment: " << title << endl;
 	ss << string(5 * indent, ' ') << "Type: numeric" << endl;
-	ss << string(5 * indent, ' ') << "Contains " << measurementCounter << " valid measurements and " << errorCounter << " errors." << endl;
-	ss << string(5 * indent, ' ') << "Average: " << this->getAverage() << "+/-" << this->getErrorOnMean() << " " 
-		<< this->measurements[0].getUnit() << endl;
-	ss << string(5 * indent, ' ') << "Standard deviation: " << this->getStandardDeviation() << " " 
-		<< this->measurements[0].getUnit() << endl << endl;
-	// Get vector of measurement occurences
-	vector<tuple<V, size_t, double>> occurences{ this->countOccurrences() };
+	ss << string(5 * indent, ' ') << "Contains " << getMeasurementCounter() << " valid measurements and " << getErrorCounter() << " errors." << endl;
+	// Find all the statistics in one pass over the data
+	dataSummary stats{ this->summary() };
+	ss << string(5 * indent, ' ') << "Average: " << stats.mean << "+/-" << stats.getErrorOnMean() << " " 
+		<< this->getUnit() << endl;
+	ss << string(5 * indent, ' ') << "Standard deviation: " << stats.getStandardDeviation() << " " 
+		<< this->getUnit() << endl;
+	// Quantiles from the sketch of the values plus systematic errors, like the average. These are exact until the sketch starts
+	// compacting, then approximate
+	vector<double> quantiles{ this->getSketch().getQuantiles({ 0.25, 0.5, 0.75, 0.9, 0.99 }) };
+	ss << string(5 * indent, ' ') << "Median: " << quantiles[1] << " " << this->getUnit() << " (Interquartile range " << quantiles[0]
+		<< " to " << quantiles[2] << ", width " << quantiles[2] - quantiles[0] << ")" << endl;
+	ss << string(5 * indent, ' ') << "90th percentile: " << quantiles[3] << " " << this->getUnit() << ", 99th percentile: "
+		<< quantiles[4] << " " << this->getUnit() << endl << endl;
+	// Get the histogram of the values
+	histogram distribution{ this->getDistribution() };
 	ss << string(5 * indent, ' ') << "The distribution of the values is the following:" << endl;
-	double binSize{ get<0>(occurences[1]) - get<0>(occurences[0]) };
-	for (size_t i{ 0 }; i < occurences.size(); i++) {
-		ss << string(5 * indent, ' ') << "(" << get<0>(occurences[0]) + i*binSize << "-" << get<0>(occurences[0]) + (i + 1)*binSize << "): "
-			<< get<1>(occurences[i]) << " entries " << "(= " << get<2>(occurences[i]) << "%)" << endl;
+	// Bins can have different widths, so each bin runs from its edge to the next one, and the last edge is the largest value
+	for (size_t i{ 0 }; i < distribution.counts.size(); i++) {
+		ss << string(5 * indent, ' ') << "(" << distribution.edges[i] << "-" << distribution.edges[i + 1] << "): "
+			<< distribution.counts[i] << " entries " << "(= " << 100 * double(distribution.counts[i]) / double(getMeasurementCounter())
+			<< "%)" << endl;
 	}
 	ss << string(5 * indent, ' ') << "--------------------------------------------" << endl;
 	experimentCounter++;
@@ -599,13 +835,7 @@ template<class V> stringstream experiment<V>::makeReport(int indent) {
 	}
 	if (correlatedExperimentCounter == 1 && stringCorrelatedVector.size() == 1) {
 		// One numeric and one string, perform numericStringCorrelation function
-		vector<pair<string, double>> stringAverages{ this->numericStringCorrelation(*(stringCorrelatedVector[0])) };
-
-		ss << string(5 * indent - 5, ' ') << "The average numeric value corresponding to each string outcome is the following:" << endl;
-		for (size_t i{ 0 }; i < stringAverages.size(); i++) {
-			ss << string(5 * indent - 5, ' ') << get<0>(stringAverages[i]) << ": " << get<1>(stringAverages[i]) 
-				<< " "<< this->measurements[0].getUnit() << endl;
-		}
+		reportStringCorrelation(ss, this->numericStringCorrelation(*(stringCorrelatedVector[0])), this->getUnit(), indent);
 	}
 
 	return ss;
@@ -624,12 +854,11 @@ template<> stringstream experiment<string>::makeReport(int indent) {
 	}
 	ss << string(5 * indent, ' ') << "Experiment: " << title << endl;
 	ss << string(5 * indent, ' ') << "Type: string" << endl;
-	ss << string(5 * indent, ' ') << "Contains " << measurementCounter << " valid measurements and " << errorCounter << " errors." << endl << endl;
+	ss << string(5 * indent, ' ') << "Contains " << getMeasurementCounter() << " valid measurements and " << getErrorCounter() << " errors." << endl << endl;
 	// Get vector of measurement occurences
 	ss << string(5 * indent, ' ') << "The most commmon entries were the following:" << endl;
-	vector<tuple<string, size_t, double>> occurences{ this->countOccurrences() };
+	vector<tuple<string, size_t, double>> occurences{ this->countOccurrences(6) };
 	for (size_t i{ 0 }; i < occurences.size(); i++) {
-		if (i > 5) { break; }
 		ss << string(5 * indent, ' ') << "Value " << get<0>(occurences[i]) << " found ";
 		ss << get<1>(occurences[i]) << " times (= " << get<2>(occurences[i]) << "%)" << endl;
 	}
@@ -651,13 +880,8 @@ template<> stringstream experiment<string>::makeReport(int indent) {
 
 	if (correlatedExperimentCounter == 1 && numericCorrelatedVector.size() == 1) {
 		// One numeric and one string, perform numericStringCorrelation function
-		vector<pair<string, double>> stringAverages{ this->numericStringCorrelation(*(numericCorrelatedVector[0])) };
-
-		ss << string(5 * indent - 5, ' ') << "The average numeric value corresponding to each string outcome is the following:" << endl;
-		for (size_t i{ 0 }; i < stringAverages.size(); i++) {
-			ss << string(5 * indent - 5, ' ') << get<0>(stringAverages[i]) << ": " << get<1>(stringAverages[i])
-				<< " " << numericCorrelatedVector[0]->getMeasurement(0).getUnit() << endl;
-		}
+		reportStringCorrelation(ss, this->numericStringCorrelation(*(numericCorrelatedVector[0])),
+			numericCorrelatedVector[0]->getUnit(), indent);
 	}
 
 	return ss;
@@ -0,0 +1,305 @@
+// This header contains the experimentRegistry class and the experimentHandle it gives out. The registry owns every experiment in the
+// program which isn't correlated to another, and keeps an index of the title of every experiment (including correlated experiments)
+// Experiments are refered to by handles, which stay the same until the experiment is removed however many others are added or removed
+// The experiment class is a template, so like mainMenu.h everything is defined in the header
+
+#ifndef EXPERIMENT_REGISTRY_CLASS_H
+#define EXPERIMENT_REGISTRY_CLASS_H
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<memory>
+#include<cstdint>
+#include<utility>
+#include<unordered_map>
+#include"experimentClass.h"
+
+// Types of experiment
+enum experimentType : unsigned char { numericExperiment, stringExperiment };
+
+// Structure refering to an experiment in the registry. id is the position of the experiment in the registry, and is never reused
+struct experimentHandle {
+	experimentType type;
+	uint32_t id;
+
+	bool operator==(const experimentHandle & handle) const { return (type == handle.type && id == handle.id); }
+	bool operator!=(const experimentHandle & handle) const { return (!(*this == handle)); }
+};
+
+// Class owning the experiments of the program
+class experimentRegistry {
+private:
+	// Experiments by id. Removing an experiment only empties its place, so no other experiment moves
+	vector<unique_ptr<experiment<double>>> numericExperiments;
+	vector<unique_ptr<experiment<string>>> stringExperiments;
+	// Number of places which aren't empty
+	size_t numericCount, stringCount;
+	// Index from the title of every experiment, including correlated experiments, to the experiment holding it (Itself if it
+	// isn't correlated)
+	unordered_map<string, experimentHandle> titles;
+
+	// Functions to give an experiment and its correlated experiments the holder given in the index, or to remove them all from it
+	template <class V> void indexTitles(const experiment<V>* exp, const experimentHandle & holder);
+	template <class V> void removeTitles(const experiment<V>* exp);
+
+public:
+	// Default constructor
+	experimentRegistry();
+
+	// The registry owns its experiments, so it can't be copied
+	experimentRegistry(const experimentRegistry &registry) = delete;
+	experimentRegistry & operator=(const experimentRegistry &registry) = delete;
+
+	// Function to swap every experiment with another registry
+	void swap(experimentRegistry & registry);
+
+	// Function to delete every experiment
+	void clear();
+
+	// Functions to take ownership of a new experiment (Along with any experiments correlated to it), returning its handle
+	experimentHandle add(experiment<double>* exp);
+	experimentHandle add(experiment<string>* exp);
+
+	// Functions to correlate an experiment to one which is already in the registry inside holder (Or is holder itself)
+	// The child is owned by parent from then on
+	template <class P> void addCorrelated(const experimentHandle & holder, experiment<P>* parent, experiment<double>* child);
+	template <class P> void addCorrelated(const experimentHandle & holder, experiment<P>* parent, experiment<string>* child);
+
+	// Function to delete an experiment and its correlated experiments. Returns false if the handle doesn't refer to an experiment
+	bool remove(const experimentHandle & handle);
+
+	// Functions to take an experiment out of the registry without deleting it, returning NULL if the handle isn't for that type
+	experiment<double>* releaseNumeric(const experimentHandle & handle);
+	experiment<string>* releaseString(const experimentHandle & handle);
+
+	// Function to store the second experiment inside the first. Both must be different experiments which aren't correlated
+	// Returns false if they can't be correlated
+	bool correlate(const experimentHandle & first, const experimentHandle & second);
+
+	// Function to change the title of an experiment in the registry (Correlated or not)
+	template <class V> void rename(experiment<V>* exp, const string & newTitle);
+
+	// Function to find the handle of an experiment given its title. Returns false if there is no experiment with that title,
+	// or it is correlated to another experiment
+	bool find(const string & title, experimentHandle & handle) const;
+
+	// Function to find the handle of the experiment holding an experiment given its title (Itself if it isn't correlated)
+	// Returns false if there is no experiment with that title
+	bool findHolder(const string & title, experimentHandle & holder) const;
+
+	// Function to check if an experiment has a title (Including correlated experiments)
+	bool contains(const string & title) const { return (titles.count(title) != 0); }
+
+	// Function to check if a handle refers to an experiment in the registry
+	bool isValid(const experimentHandle & handle) const;
+
+	// Functions to access the experiment refered to by a handle. Return NULL if the handle isn't valid for that type
+	experiment<double>* getNumeric(const experimentHandle & handle) const;
+	experiment<string>* getString(const experimentHandle & handle) const;
+
+	// Function for the title of the experiment refered to by a valid handle
+	const string & getTitle(const experimentHandle & handle) const;
+
+	// Functions for all the experiments which aren't correlated, in the order they were added
+	vector<experimentHandle> getHandles() const;
+	vector<experiment<double>*> getNumericExperiments() const;
+	vector<experiment<string>*> getStringExperiments() const;
+
+	// Accesor functions for the number of experiments which aren't correlated
+	size_t getNumericCount() const { return (numericCount); }
+	size_t getStringCount() const { return (stringCount); }
+	size_t size() const { return (numericCount + stringCount); }
+};
+
+// ############################## //
+// #    Function definitions    # //
+// ############################## //
+
+// Default constructor
+experimentRegistry::experimentRegistry() : numericCount{ 0 }, stringCount{ 0 } {}
+
+// Function to swap every experiment with another registry
+void experimentRegistry::swap(experimentRegistry & registry) {
+	numericExperiments.swap(registry.numericExperiments);
+	stringExperiments.swap(registry.stringExperiments);
+	std::swap(numericCount, registry.numericCount);
+	std::swap(stringCount, registry.stringCount);
+	titles.swap(registry.titles);
+}
+
+// Function to delete every experiment
+void experimentRegistry::clear() {
+	numericExperiments.clear();
+	stringExperiments.clear();
+	numericCount = 0;
+	stringCount = 0;
+	titles.clear();
+}
+
+// Function to give an experiment and its correlated experiments the holder given in the index
+template <class V> void experimentRegistry::indexTitles(const experiment<V>* exp, const experimentHandle & holder) {
+	titles[exp->getTitle()] = holder;
+	for (size_t i{ 0 }; i < exp->getNumericCorrelatedVector().size(); i++) { indexTitles(exp->getNumericCorrelatedVector()[i], holder); }
+	for (size_t i{ 0 }; i < exp->getStringCorrelatedVector().size(); i++) { indexTitles(exp->getStringCorrelatedVector()[i], holder); }
+}
+
+// Function to remove an experiment and its correlated experiments from the index
+template <class V> void experimentRegistry::removeTitles(const experiment<V>* exp) {
+	titles.erase(exp->getTitle());
+	for (size_t i{ 0 }; i < exp->getNumericCorrelatedVector().size(); i++) { removeTitles(exp->getNumericCorrelatedVector()[i]); }
+	for (size_t i{ 0 }; i < exp->getStringCorrelatedVector().size(); i++) { removeTitles(exp->getStringCorrelatedVector()[i]); }
+}
+
+// Functions to take ownership of a new experiment
+experimentHandle experimentRegistry::add(experiment<double>* exp) {
+	experimentHandle handle{ numericExperiment, uint32_t(numericExperiments.size()) };
+	numericExperiments.emplace_back(exp);
+	numericCount++;
+	indexTitles(exp, handle);
+	return (handle);
+}
+experimentHandle experimentRegistry::add(experiment<string>* exp) {
+	experimentHandle handle{ stringExperiment, uint32_t(stringExperiments.size()) };
+	stringExperiments.emplace_back(exp);
+	stringCount++;
+	indexTitles(exp, handle);
+	return (handle);
+}
+
+// Functions to correlate an experiment to one which is already in the registry
+template <class P> void experimentRegistry::addCorrelated(const experimentHandle & holder, experiment<P>* parent,
+	experiment<double>* child) {
+	parent->getNumericCorrelatedVector().push_back(child);
+	indexTitles(child, holder);
+}
+template <class P> void experimentRegistry::addCorrelated(const experimentHandle & holder, experiment<P>* parent,
+	experiment<string>* child) {
+	parent->getStringCorrelatedVector().push_back(child);
+	indexTitles(child, holder);
+}
+
+// Function to delete an experiment and its correlated experiments
+bool experimentRegistry::remove(const experimentHandle & handle) {
+	if (handle.type == numericExperiment) {
+		experiment<double>* exp{ releaseNumeric(handle) };
+		delete exp;
+		return (exp != NULL);
+	}
+	experiment<string>* exp{ releaseString(handle) };
+	delete exp;
+	return (exp != NULL);
+}
+
+// Functions to take an experiment out of the registry without deleting it
+experiment<double>* experimentRegistry::releaseNumeric(const experimentHandle & handle) {
+	experiment<double>* exp{ getNumeric(handle) };
+	if (exp == NULL) { return (NULL); }
+	removeTitles(exp);
+	numericExperiments[handle.id].release();
+	numericCount--;
+	return (exp);
+}
+experiment<string>* experimentRegistry::releaseString(const experimentHandle & handle) {
+	experiment<string>* exp{ getString(handle) };
+	if (exp == NULL) { return (NULL); }
+	removeTitles(exp);
+	stringExperiments[handle.id].release();
+	stringCount--;
+	return (exp);
+}
+
+// Function to store the second experiment inside the first
+bool experimentRegistry::correlate(const experimentHandle & first, const experimentHandle & second) {
+	if (first == second || !isValid(first) || !isValid(second)) { return (false); }
+	if (first.type == numericExperiment) {
+		if (second.type == numericExperiment) { addCorrelated(first, getNumeric(first), releaseNumeric(second)); }
+		else { addCorrelated(first, getNumeric(first), releaseString(second)); }
+	}
+	else {
+		if (second.type == numericExperiment) { addCorrelated(first, getString(first), releaseNumeric(second)); }
+		else { addCorrelated(first, getString(first), releaseString(second)); }
+	}
+	return (true);
+}
+
+// Function to change the title of an experiment in the registry
+template <class V> void experimentRegistry::rename(experiment<V>* exp, const string & newTitle) {
+	unordered_map<string, experimentHandle>::iterator found{ titles.find(exp->getTitle()) };
+	if (found != titles.end()) {
+		experimentHandle holder{ found->second };
+		titles.erase(found);
+		titles[newTitle] = holder;
+	}
+	exp->setTitle(newTitle);
+}
+
+// Function to find the handle of an experiment given its title
+bool experimentRegistry::find(const string & title, experimentHandle & handle) const {
+	unordered_map<string, experimentHandle>::const_iterator found{ titles.find(title) };
+	// Correlated experiments are indexed by the experiment holding them, which has a different title
+	if (found == titles.end() || getTitle(found->second) != title) { return (false); }
+	handle = found->second;
+	return (true);
+}
+
+// Function to find the handle of the experiment holding an experiment given its title
+bool experimentRegistry::findHolder(const string & title, experimentHandle & holder) const {
+	unordered_map<string, experimentHandle>::const_iterator found{ titles.find(title) };
+	if (found == titles.end()) { return (false); }
+	holder = found->second;
+	return (true);
+}
+
+// Function to check if a handle refers to an experiment in the registry
+bool experimentRegistry::isValid(const experimentHandle & handle) const {
+	if (handle.type == numericExperiment) { return (handle.id < numericExperiments.size() && numericExperiments[handle.id] != nullptr); }
+	return (handle.id < stringExperiments.size() && stringExperiments[handle.id] != nullptr);
+}
+
+// Functions to access the experiment refered to by a handle
+experiment<double>* experimentRegistry::getNumeric(const experimentHandle & handle) const {
+	if (handle.type != numericExperiment || handle.id >= numericExperiments.size()) { return (NULL); }
+	return (numericExperiments[handle.id].get());
+}
+experiment<string>* experimentRegistry::getString(const experimentHandle & handle) const {
+	if (handle.type != stringExperiment || handle.id >= stringExperiments.size()) { return (NULL); }
+	return (stringExperiments[handle.id].get());
+}
+
+// Function for the title of the experiment refered to by a valid handle
+const string & experimentRegistry::getTitle(const experimentHandle & handle) const {
+	if (handle.type == numericExperiment) { return (numericExperiments[handle.id]->getTitle()); }
+	return (stringExperiments[handle.id]->getTitle());
+}
+
+// Functions for all the experiments which aren't correlated, in the order they were added
+vector<experimentHandle> experimentRegistry::getHandles() const {
+	vector<experimentHandle> handles;
+	handles.reserve(size());
+	for (size_t i{ 0 }; i < numericExperiments.size(); i++) {
+		if (numericExperiments[i] != nullptr) { handles.push_back(experimentHandle{ numericExperiment, uint32_t(i) }); }
+	}
+	for (size_t i{ 0 }; i < stringExperiments.size(); i++) {
+		if (stringExperiments[i] != nullptr) { handles.push_back(experimentHandle{ stringExperiment, uint32_t(i) }); }
+	}
+	return (handles);
+}
+vector<experiment<double>*> experimentRegistry::getNumericExperiments() const {
+	vector<experiment<double>*> output;
+	output.reserve(numericCount);
+	for (size_t i{ 0 }; i < numericExperiments.size(); i++) {
+		if (numericExperiments[i] != nullptr) { output.push_back(numericExperiments[i].get()); }
+	}
+	return (output);
+}
+vector<experiment<string>*> experimentRegistry::getStringExperiments() const {
+	vector<experiment<string>*> output;
+	output.reserve(stringCount);
+	for (size_t i{ 0 }; i < stringExperiments.size(); i++) {
+		if (stringExperiments[i] != nullptr) { output.push_back(stringExperiments[i].get()); }
+	}
+	return (output);
+}
+
+#endif
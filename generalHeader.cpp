@@ -6,36 +6,22 @@ using namespace std;
 #include<iostream>
 #include<fstream>
 #include<tuple>
+#include<string_view>
+#include<charconv>
+#include<cctype>
 
 #include"generalHeader.h"
 
-// A function to test if a string can be made an integer with the std::stoi function
-bool isStringInt(const string & input) {
-	bool isInt{ true };
-	for (size_t i{ 0 }; i < input.length(); i++) {
-		if (!isdigit(input[i])) { isInt = false; }
-	}
-	return(isInt);
-}
-
-// Function to determine if a string corresponds to a number or not with the std::stod function (Works for integers and non integers)
-bool isStringNum(const string & input) {
-	bool isNum{ true };
-	size_t decimalPoints{ 0 }, numberOfDigits{ 0 };
-	size_t counter{ 0 };
-	// Check for - or + signs at the beggining (Only accepts 1, to match the std::stod function)
-	if (input[counter] == '+' || input[counter] == '-') { counter++; }
-	// Check for decimal points
-	while (counter < input.size()) {
-		if (input[counter] != '.') {
-			if (isdigit(input[counter])) { numberOfDigits++; }
-			else { isNum = false; }
-		}
-		else { decimalPoints++; }
-		counter++;
-	}
-	if (decimalPoints > 1 || numberOfDigits == 0) { isNum = false; }
-	return (isNum);
+// A function to test if a string is a positive integer
+bool isStringInt(string_view input) {
+	size_t number;
+	return (stringToSize(input, number));
+}
+
+// Function to determine if a string corresponds to a number or not
+bool isStringNum(string_view input) {
+	double number;
+	return (stringToDouble(input, number));
 }
 
 // Function to remove any whitespace from a string
@@ -56,6 +42,15 @@ string makeLowerCase(const string & input) {
 	return(output);
 }
 
+// A function to check if a string is equal to a lower case string, ignoring the case of the first string
+bool equalsLowerCase(string_view input, string_view lowerCase) {
+	if (input.size() != lowerCase.size()) { return (false); }
+	for (size_t i{ 0 }; i < input.size(); i++) {
+		if ((char)tolower((unsigned char)input[i]) != lowerCase[i]) { return (false); }
+	}
+	return (true);
+}
+
 // A function that can discriminate between types of answer returning an integer corresponding to which type
 // Input will me a vector of vectors, like a matrix where the nth row will be the nth type of response. Integer return type contains the 
 // number of row that the users input belonged to. Starts conting from 0
@@ -79,15 +74,104 @@ int testUserInput(const vector<vector<string>> & validInputs) {
 	return(output);
 }
 
+// A function to check if a name matches a pattern, where * matches any number of characters and ? matches any single character
+bool matchesPattern(string_view name, string_view pattern) {
+	size_t n{ 0 }, p{ 0 };
+	// Position of the last * in the pattern, and the position in the name it was matched from
+	size_t star{ string_view::npos }, starMatch{ 0 };
+	while (n < name.size()) {
+		if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) { n++; p++; }
+		else if (p < pattern.size() && pattern[p] == '*') { star = p; starMatch = n; p++; }
+		else if (star != string_view::npos) {
+			// Let the last * match one more character and try again from there
+			starMatch++;
+			n = starMatch;
+			p = star + 1;
+		}
+		else { return (false); }
+	}
+	while (p < pattern.size() && pattern[p] == '*') { p++; }
+	return (p == pattern.size());
+}
+
 // A function to split a sting up into substrings by commas
-vector<string> splitString(string input) {
-	vector<string> output;
-	while (input.find(',') != string::npos) {
-		output.push_back(input.substr(0, input.find(',')));
-		input.erase(0, input.find(',') + 1);
-		while (input[0] == ' ' || input[0] == '\t' || input[0] == ',') { input.erase(0, 1); }
+vector<string> splitString(string_view input) {
+	vector<string_view> substrings;
+	splitStringView(input, substrings);
+	return (vector<string>(substrings.begin(), substrings.end()));
+}
+
+// A function to split a string up by commas in the same way as splitString, without copying
+// Each character is looked at once, so long lines take no longer per character than short ones
+void splitStringView(string_view input, vector<string_view> & output) {
+	output.clear();
+	size_t start{ 0 }, comma{ input.find(',') };
+	while (comma != string_view::npos) {
+		output.push_back(input.substr(start, comma - start));
+		start = comma + 1;
+		while (start < input.size() && (input[start] == ' ' || input[start] == '\t' || input[start] == ',')) { start++; }
+		comma = input.find(',', start);
+	}
+	output.push_back(input.substr(min(start, input.size())));
+}
+
+// A function to find the next line of a block of text starting from position, which is then moved to the start of the following line
+bool getNextLine(string_view text, size_t & position, string_view & line) {
+	if (position >= text.size()) { return (false); }
+	size_t lineEnd{ text.find('\n', position) };
+	if (lineEnd == string_view::npos) { lineEnd = text.size(); }
+	line = text.substr(position, lineEnd - position);
+	while (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+	position = lineEnd + 1;
+	return (true);
+}
+
+// A function to find the first line of a block of text, starting from position, which is exactly the given line
+size_t findLine(string_view text, size_t position, string_view line) {
+	size_t found{ text.find(line, position) };
+	while (found != string_view::npos) {
+		// Must be a whole line: at the start of a line, and followed only by carriage returns before the end of the line
+		size_t after{ found + line.size() };
+		while (after < text.size() && text[after] == '\r') { after++; }
+		if ((found == position || text[found - 1] == '\n') && (after == text.size() || text[after] == '\n')) { return (found); }
+		found = text.find(line, found + 1);
 	}
-	output.push_back(input);
-	return output;
+	return (string_view::npos);
+}
+
+// Function to convert a whole string to a double with std::from_chars, returning false if it isn't a valid number
+bool stringToDouble(string_view input, double & output) {
+	// Only one sign is allowed, and infinity and nan are not valid measurements
+	size_t firstDigit{ (!input.empty() && (input[0] == '-' || input[0] == '+')) ? size_t(1) : size_t(0) };
+	if (firstDigit >= input.size() || !(isdigit((unsigned char)input[firstDigit]) || input[firstDigit] == '.')) { return (false); }
+	// from_chars doesn't accept a leading + sign, unlike std::stod
+	if (input[0] == '+') { input.remove_prefix(1); }
+	from_chars_result result{ from_chars(input.data(), input.data() + input.size(), output) };
+	return (result.ec == errc() && result.ptr == input.data() + input.size());
 }
 
+// Function to convert a whole string to a positive integer with std::from_chars, returning false if it isn't a valid integer
+bool stringToSize(string_view input, size_t & output) {
+	if (input.empty()) { return (false); }
+	from_chars_result result{ from_chars(input.data(), input.data() + input.size(), output) };
+	return (result.ec == errc() && result.ptr == input.data() + input.size());
+}
+
+// Function to add a double to the end of a string, formatted in the same way as the << operator of ostream
+void appendToString(string & output, const double & number) {
+	char digits[32];
+	to_chars_result result{ to_chars(digits, digits + sizeof(digits), number, chars_format::general, 6) };
+	output.append(digits, result.ptr);
+}
+
+// Function to add a positive integer to the end of a string
+void appendToString(string & output, const size_t & number) {
+	char digits[24];
+	to_chars_result result{ to_chars(digits, digits + sizeof(digits), number) };
+	output.append(digits, result.ptr);
+}
+
+// Function to add a string to the end of another string
+void appendToString(string & output, string_view text) {
+	output += text;
+}
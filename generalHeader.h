@@ -10,12 +10,14 @@ using namespace std;
 #include<string>
 #include<vector>
 #include<iostream>
+#include<string_view>
 
-// A function to test if a string can be made an integer with the std::stoi function
-bool isStringInt(const string & input);
+// A function to test if a string is a positive integer, in the same way as stringToSize
+bool isStringInt(string_view input);
 
-// Function to determine if a string corresponds to a number or not with the std::stod function (Works for integers and non integers)
-bool isStringNum(const string & input);
+// Function to determine if a string corresponds to a number or not, in the same way as stringToDouble (Works for integers, non integers
+// and scientific notation). Where the number is needed stringToDouble should be used instead, which checks and converts in one go
+bool isStringNum(string_view input);
 
 // Function to remove any whitespace from a string
 string removeWhitespace(const string & input);
@@ -23,12 +25,42 @@ string removeWhitespace(const string & input);
 // A function that can make any string all lower case
 string makeLowerCase(const string & input);
 
+// A function to check if a string is equal to a lower case string, ignoring the case of the first string (Without making a lower case copy)
+bool equalsLowerCase(string_view input, string_view lowerCase);
+
 // A function that can discriminate between types of answer returning an integer corresponding to which type
 // Input will me a vector of vectors, like a matrix where the nth row will be the nth type of response. Integer return type contains the 
 // number of row that the users input belonged to. Starts conting from 0
 int testUserInput(const vector<vector<string>> & validInputs);
 
-// A function to split a sting up into substrings by commas
-vector<string> splitString(string input);
+// A function to check if a name matches a pattern, where * matches any number of characters and ? matches any single character
+bool matchesPattern(string_view name, string_view pattern);
+
+// A function to split a sting up into substrings by commas. Spaces, tabs and extra commas after each comma are skipped
+// This copies every substring, so splitStringView should be used for anything read often (eg. lines of a file)
+vector<string> splitString(string_view input);
+
+// A function to split a string up by commas in the same way as splitString, without copying. The substrings point in to the input,
+// so it must outlive them. The output vector is cleared first, so it can be reused for every line of a file
+void splitStringView(string_view input, vector<string_view> & output);
+
+// A function to find the next line of a block of text starting from position, which is then moved to the start of the following line
+// Carriage returns at the end of the line are removed. Returns false once the end of the text is reached
+bool getNextLine(string_view text, size_t & position, string_view & line);
+
+// A function to find the first line of a block of text, starting from position, which is exactly the given line (Ignoring carriage returns
+// at the end). Returns the position of the start of that line, or string_view::npos if there isn't one
+size_t findLine(string_view text, size_t position, string_view line);
+
+// Functions to convert a whole string to a number with std::from_chars, returning false if it isn't a valid number
+// These never throw. Numbers can have one + or - sign, a decimal point and an exponent (eg. 1.5e-3), but infinity, nan and hex are not valid
+bool stringToDouble(string_view input, double & output);
+bool stringToSize(string_view input, size_t & output);
+
+// Functions to add a number or a string to the end of a string, without making a temporary string
+// Doubles are formatted in the same way as the << operator of ostream (6 significant figures)
+void appendToString(string & output, const double & number);
+void appendToString(string & output, const size_t & number);
+void appendToString(string & output, string_view text);
 
 #endif
\ No newline at end of file
@@ -11,13 +11,24 @@ using namespace std;
 #include<fstream>
 #include<utility>
 #include<stdio.h>
+#include<string_view>
+#include<chrono>
+#include<future>
+#include<unordered_map>
+#include<filesystem>
+#include<sstream>
+#include<thread>
+#include<atomic>
 
 #include"generalHeader.h"
 #include"experimentClass.h"
+#include"mappedFileClass.h"
+#include"atomicFileClass.h"
+#include"chunkReaderClass.h"
+#include"experimentRegistryClass.h"
 
 // Declare the essential experiment storage in the header so it is accessible to the whole program
-extern vector<experiment<double>*> numericExperimentVector;
-extern vector<experiment<string>*> stringExperimentVector;
+extern experimentRegistry experiments;
 
 // Create a namespace for the main manu section of the code
 // A seperate namespace will help keep functions seperate given the names are quite generic
@@ -27,7 +38,8 @@ namespace mainMenu {
 	// Notes //
 	//#######//
 
-	// In these functions the word "coordinates" refers to a pair returning an experiments type and index in the respective experiment vector
+	// In these functions experiments are refered to by their handle in the registry, which stays the same while other experiments
+	// are added or deleted
 	
 	// Most of these experiments return bool types with the idea that 'false' types indicate some kind of error, while 'true' indicates success
 	// In many cases they could have been void types
@@ -36,10 +48,14 @@ namespace mainMenu {
 	// in seperate cpp files. That being said, I kept the declarations and definitions seperate, and the f12 shortcut allows quick access to
 	// a definition from the declaration
 
-	// A function to find an experiments coordinates given its name
-	pair<string, size_t> getExperimentPair(const string & input);
+	// Handle used when no experiment is given, such as a report of every experiment
+	const experimentHandle noExperiment{ numericExperiment, UINT32_MAX };
 
-	// A function to check if an experiment name already exists or not
+	// A function to find an experiments handle given its name. Exits the program if there is no such experiment, so should only be
+	// used for names that are known to exist
+	experimentHandle getExperimentHandle(const string & input);
+
+	// A function to check if an experiment name already exists or not (Including correlated experiments)
 	bool checkTitle(const string & input);
 
 	// A function to show the user all the experiments, and give more actions for them
@@ -48,30 +64,305 @@ namespace mainMenu {
 	// A function to add an experiment either by file or by keyboard
 	bool addExperiment();
 
+	// A function to add an experiment for each file in a list of data files (Names can use wildcards), titled by the file names
+	// The files are read at the same time on several threads (As many as used for statistics), and a report of each file is shown
+	bool ingestFiles();
+
 	// A function to delete a given experiment and its correlated experiments
-	bool deletExperiment(const pair<string, size_t> & exp);
+	bool deletExperiment(const experimentHandle & exp);
 
 	// A function to generate a report for an experiment to file or screen, or all experiments if default parameter used
-	bool makeReport(const pair<string, size_t> & input = pair<string, size_t>{"null",0});
+	bool makeReport(const experimentHandle & input = noExperiment);
 
 	// A function to make a save file of all data in the current instance of the program
+	// Save files are written atomically, and can be written in the background from a copy of the experiments
 	bool saveData();
 
+	// A function to check if a background save has finished, telling the user the result. If wait is true it waits for the save first
+	void checkBackgroundSave(const bool & wait);
+
 	// A function to load a save file of data
 	bool loadData();
 
 	// A function to change the name of an experiment
-	bool rename(const pair<string,size_t> & currentExperiment);
+	bool rename(const experimentHandle & currentExperiment);
 
 	// A function that allows experiments to be correlated, for example temperature and pressure measurements.
 	// Order matters in this process. Exp2 will be stored inside of Exp1, with the idea that Exp1 is the independent variable
-	bool correlate(const pair<string, size_t> & exp1, const pair<string, size_t> & exp2, const bool & checkOrder = true);
+	bool correlate(const experimentHandle & exp1, const experimentHandle & exp2, const bool & checkOrder = true);
+
+	// A function to let the user change the settings of the program, such as the number of threads used for statistics
+	bool changeSettings();
+
+	// A function to convert a save file from text to binary, or from binary to text. Journals are converted to binary
+	bool convertSaveFile();
 
 	// Collection of functions useful for the data extraction in this program
 	namespace dataExtraction {
 		// A function to take the first input of measurement from the file and check its type
 		// Will return true for valid types, false for invalid, and automatically update counters
 		bool checkMeasurementType(const string & input, vector<size_t> & counters);
+
+		// Types of line in a data file. These are also the positions of the counters in checkMeasurementType
+		enum dataLineType : unsigned char { numericLine, stringLine, errorLine };
+
+		// Structure for one line of a data file once it has been checked and converted, so no line has to be read twice
+		struct parsedDataLine {
+			double value, error, systError;	// Numeric measurements only
+			uint64_t packedDate;	// Timestamp of the measurement (See timestamp::getPackedDate)
+			uint32_t text;	// Position in the text table of the unit of a numeric measurement, or the value of a string measurement
+			dataLineType type;
+		};
+
+		// Structure for the different units and string values found in a block of data. The texts point in to the data
+		struct dataTextTable {
+			vector<string_view> texts;
+			unordered_map<string_view, uint32_t> positions;
+		};
+
+		// A function to find the position of a text in a text table, adding it if it is new
+		uint32_t findDataText(string_view text, dataTextTable & table);
+
+		// A function to check and convert one line of a data file in a single pass. The rules are the same as checkMeasurementType
+		// substrings is only used to split the line, so it can be reused for every line. Returns false if the line isn't valid
+		bool parseDataLine(string_view line, vector<string_view> & substrings, dataTextTable & texts, parsedDataLine & output);
+
+		// Functions to check and convert one line of a numeric or string experiment in a text save file, in the same way as parseDataLine
+		// In a numeric experiment any line not starting with a number is an error, and in a string experiment only "error" is
+		bool parseNumericSaveLine(string_view line, vector<string_view> & substrings, dataTextTable & texts, parsedDataLine & output);
+		bool parseStringSaveLine(string_view line, vector<string_view> & substrings, dataTextTable & texts, parsedDataLine & output);
+
+		// Type of the line functions above
+		typedef bool(*lineParser)(string_view, vector<string_view> &, dataTextTable &, parsedDataLine &);
+
+		// Structure for one chunk of lines once they have been checked and converted (See chunkReaderClass.h)
+		struct parsedDataBatch {
+			vector<parsedDataLine> lines;
+			dataTextTable texts;
+			size_t counters[3]{ 0,0,0 };	// Number of lines of each dataLineType
+			size_t lineCount{ 0 };	// Number of lines in the chunk, including empty lines
+			size_t bytes{ 0 };	// Size of the chunk
+			size_t invalidLine{ 0 };	// Line number in the chunk of the first line that isn't valid (Starting from 1), or 0 if they all are
+			string_view invalidText;
+		};
+
+		// A function to check and convert every line of a chunk with parseLine, stopping at the first line that isn't valid
+		// Empty lines are skipped
+		void parseDataChunk(string_view chunk, const lineParser & parseLine, parsedDataBatch & output);
+
+		// Functions to add the lines of a batch to an experiment, in order
+		void addParsedLines(const parsedDataBatch & batch, experiment<double>* exp);
+		void addParsedLines(const parsedDataBatch & batch, experiment<string>* exp);
+
+		// Structure describing the result of reading a data file in to a new experiment. Only one of the two pointers is used, depending on
+		// the type of measurements in the file, and both are NULL if the file isn't valid
+		struct dataFileResult {
+			bool valid;
+			string message;	// Reason the file isn't valid
+			experiment<double>* numericExp;
+			experiment<string>* stringExp;
+			size_t measurements, errors, bytes;
+		};
+
+		// A function to read a data file in to a new experiment, which isn't added to the program
+		// Only changes the experiment it creates, so files can be read on several threads
+		dataFileResult readDataFile(const string & fileName, const string & title, const size_t & threads = getStatisticsThreads());
+
+		// A function to read lines of data in to a new experiment. The lines are checked and converted with parseDataLine in chunks on
+		// the given number of threads, and each chunk is added to the experiment as soon as it is ready, so only a few chunks are held at once
+		// If a line isn't valid the experiment is deleted. Data with only errors makes a string experiment unless experimentType is "numeric"
+		dataFileResult readDataText(string_view text, const string & title, const string & experimentType = "",
+			const size_t & threads = getStatisticsThreads());
+
+		// A function to find the data files in a list of names seperated by commas. Names with * or ? wildcards are matched against the
+		// files in the data folder, in alphabetical order. Returns false if a name doesn't match any file
+		bool findDataFiles(const string & input, vector<string> & fileNames);
+
+		// A function to make an experiment title from a file name, by removing the folder and extension
+		string titleFromFileName(const string & fileName);
+
+		// A function to check the title of an experiment being loaded is new, asking the user for a new one if not
+		// Returns false if the user cancels loading
+		bool chooseLoadTitle(string & title);
+
+		// A function to read the measurements of an experiment from a save file in memory until the end line is found
+		// The lines are read in chunks on several threads in the same way as readDataText
+		// Position is moved past the end line. Returns false if the file ends early or has an invalid line
+		template <class V> bool readSaveExperiment(string_view fileData, size_t & position, experiment<V>* exp, string_view endLine,
+			const size_t & threads = getStatisticsThreads());
+
+		// A function to open a save file given the name typed by the user. Without an extension SAV_name.dat is tried, then SAV_name.bin
+		// and SAV_name.jnl
+		// fileName is set to the name of the file opened. Returns false if no file could be opened
+		bool openSaveFile(const string & name, mappedFile & file, string & fileName);
+
+		// A function to check if a save file in memory is in the binary format, by looking for the binary header
+		bool isBinarySaveFile(string_view fileData);
+
+		// Functions to add all the experiments in a save file in memory to the program, in the text or binary format
+		// Return false if the file is corrupted or the user cancels loading
+		bool loadTextSaveFile(string_view fileData);
+		bool loadBinarySaveFile(string_view fileData);
+
+		// Functions to write the given experiments to a stream, in the text or binary format. Return false if writing failed
+		bool writeTextSaveFile(ostream & output, const vector<experiment<double>*> & numericExperiments,
+			const vector<experiment<string>*> & stringExperiments);
+		bool writeBinarySaveFile(ostream & output, const vector<experiment<double>*> & numericExperiments,
+			const vector<experiment<string>*> & stringExperiments);
+
+		// Structure describing the result of writing a save file
+		struct saveResult {
+			bool written;	// True if the file was completely written and replaced the old file
+			size_t bytes;	// Size of the file
+			double seconds;	// Time taken to write it
+		};
+
+		// A function to write the given experiments to a save file in the text or binary format
+		// The data goes to a temporary file which only replaces fileName once it is on disk (See atomicFileClass.h)
+		saveResult writeSaveFile(const string & fileName, const bool & binary, const vector<experiment<double>*> & numericExperiments,
+			const vector<experiment<string>*> & stringExperiments);
+
+		// A function to tell the user the result of writing a save file
+		void printSaveResult(const string & fileName, const saveResult & result);
+
+		// A function to copy an experiment and its correlated experiments, so they can be saved in the background
+		// The copies are not counted as loaded data in experimentAccounting
+		template <class V> experiment<V>* copyForSave(const experiment<V>* exp);
+
+		// First bytes and version number of binary save files
+		const string_view binarySaveHeader{ "SAV_BIN\x1A", 8 };
+		const uint32_t binarySaveVersion{ 1 };
+
+		// Structure for an experiment in a binary save file. Only one of the two pointers is used, depending on the type
+		// parent is one more than the position of the experiment this is correlated to in the file, or 0 if it isn't correlated
+		struct binarySaveEntry {
+			experiment<double>* numericExp;
+			experiment<string>* stringExp;
+			size_t parent;
+		};
+
+		// Functions to list an experiment and its correlated experiments in the order they are written to a binary save file
+		void listBinarySaveEntries(experiment<double>* exp, const size_t & parent, vector<binarySaveEntry> & entries);
+		void listBinarySaveEntries(experiment<string>* exp, const size_t & parent, vector<binarySaveEntry> & entries);
+		template <class V> void listCorrelatedSaveEntries(experiment<V>* exp, vector<binarySaveEntry> & entries);
+
+		// A function to list every experiment in a registry in the order they are written to a binary save file
+		void listBinarySaveEntries(const experimentRegistry & registry, vector<binarySaveEntry> & entries);
+	}
+
+	// Setting for saving in the background, and the save currently running in the background if there is one
+	bool backgroundSaves{ false };
+	future<dataExtraction::saveResult> backgroundSave;
+	string backgroundSaveName;
+
+	// Collection of functions for journal save files (SAV_name.jnl). A journal starts with a snapshot of every experiment in the binary
+	// format, followed by records of the changes made since: new experiments, new measurements, renames, correlations and deletions
+	// Saving again to the journal last saved or loaded only appends records for what changed since, so the cost depends on the
+	// amount of new data rather than all the data. Once the records are bigger than the snapshot the journal is compacted in to a new one
+	namespace journal {
+		// Types of record in a journal
+		enum recordType : unsigned char { snapshotRecord = 1, addRecord, deleteRecord, renameRecord, correlateRecord, appendRecord };
+
+		// First bytes and version number of journal files, and the size of the header in front of every record
+		// (type (1 byte), length of the record (8 bytes), checksum of the record (4 bytes))
+		const string_view journalHeader{ "SAV_JNL\x1A", 8 };
+		const uint32_t journalVersion{ 1 };
+		const size_t recordHeaderSize{ 13 };
+
+		// Structure for an experiment as it was when it was last written to the journal
+		struct trackedExperiment {
+			size_t id;	// Number identifying the experiment in records (Its position in the snapshot, then in order of adding)
+			string title;
+			const void* parent;	// Experiment this is correlated to, or NULL if it isn't correlated
+			size_t measurements, errors;
+		};
+
+		// The journal being tracked: its file name (Empty if there isn't one), the number of bytes of valid records in it, the size of
+		// its snapshot, the next free id, the experiments written to it (By address), and ids of deleted experiments not yet written
+		string fileName;
+		size_t validLength{ 0 }, snapshotLength{ 0 }, nextId{ 0 };
+		unordered_map<const void*, trackedExperiment> tracked;
+		vector<size_t> pendingDeletes;
+
+		// A function to check if a save file in memory is a journal
+		bool isJournalFile(string_view fileData);
+
+		// A function to add all the experiments in a journal in memory to the program, by loading its snapshot and replaying its records
+		// A record which was only partly written is ignored, along with anything after it. If track is true, saving to journalName
+		// afterwards appends to it. Returns false if the journal is corrupted or the user cancels loading
+		bool loadJournalFile(string_view fileData, const string & journalName, const bool & track);
+
+		// A function to apply one record to the experiments loaded from a journal. byId holds the experiment with each id
+		// (Deleted experiments have both pointers NULL). Returns false if the record isn't valid
+		bool replayRecord(const recordType & type, string_view payload, vector<dataExtraction::binarySaveEntry> & byId);
+
+		// A function to save every experiment to a journal. Changes are appended if journalName is the journal being tracked,
+		// otherwise (or if the journal needs compacting) a new journal holding only a snapshot is written atomically
+		dataExtraction::saveResult saveJournal(const string & journalName);
+
+		// A function to write a new journal holding only a snapshot of every experiment, and start tracking it
+		bool writeSnapshot(const string & journalName);
+
+		// A function to add records for the changes since the journal was last written, updating the tracked experiments
+		// Returns false if a change can't be written as a record (Measurements removed or a correlation undone), so compaction is needed
+		bool findChanges(string & records);
+		template <class V> bool findExperimentChanges(experiment<V>* exp, const void* parent, string & records);
+
+		// A function to add a record to the end of a block of records
+		void addRecordTo(string & records, const recordType & type, const string & payload);
+
+		// A function to find the address of the experiment in a save entry, used to identify tracked experiments
+		const void* getEntryPointer(const dataExtraction::binarySaveEntry & entry);
+
+		// A function to describe each experiment in a list of save entries, given the id of each
+		void trackEntries(const vector<dataExtraction::binarySaveEntry> & entries, const vector<size_t> & ids,
+			unordered_map<const void*, trackedExperiment> & output);
+
+		// A function to stop tracking an experiment and its correlated experiments as they are deleted
+		// A deletion record is written at the next save if the experiment was in the journal
+		template <class V> void forgetExperiment(const experiment<V>* exp);
+	}
+
+	// Collection of functions for following a live feed of measurements: a data file which an instrument is still writing to, or a
+	// pipe. Lines are added to one experiment as they arrive, in the same format as data files, and statistics are shown as it grows
+	// No questions are asked, so a feed is started from the command line (eg. "program feed live.dat temperature --every 5")
+	namespace feed {
+		// Settings for following a feed, read from the command line
+		struct feedSettings {
+			string source;	// Data file to follow, or "-" to read the standard input
+			string title;	// Title of the experiment the measurements are added to
+			double reportSeconds;	// Time between live statistics
+			double idleSeconds;	// Time without new lines before a file stops being followed (0 follows it until the program is stopped)
+			string saveName;	// Journal saved to after each live statistics, so only the new measurements are written (Empty to not save)
+		};
+
+		// Most bytes of lines read before they are added to the experiment. Lines are also added as soon as no more are waiting
+		const size_t feedBlockSize{ 1 << 16 };
+
+		// A function to read the settings of a feed from the command line arguments after "feed". Returns false if they aren't valid
+		bool readArguments(const vector<string> & arguments, feedSettings & settings);
+
+		// A function to follow a feed until it ends, adding every line to a new experiment and showing live statistics
+		// Returns the exit code for the program
+		int followFeed(const feedSettings & settings);
+
+		// Structure for the experiment a feed is added to. The experiment is only created once the first measurement shows its type,
+		// so errors before then are kept waiting
+		struct feedState {
+			string title;
+			bool created;
+			experimentHandle handle;
+			vector<timestamp> waitingErrors;
+			size_t lineNumber, skippedLines;
+		};
+
+		// A function to add a block of complete lines to the experiment of a feed. Lines that aren't valid, or don't match the type of the
+		// experiment, are skipped with a warning rather than stopping the feed
+		void addFeedLines(string_view block, feedState & state);
+
+		// A function to show the statistics of the experiment of a feed. These are kept up to date as measurements are added, so showing
+		// them doesn't depend on the size of the experiment
+		void printLiveStatistics(const feedState & state, const double & seconds);
 	}
 }
 
@@ -79,35 +370,25 @@ namespace mainMenu {
 // Function definitions //
 // #################### //
 
-// A function to find an experiments coordinates given its name
-pair<string, size_t> mainMenu::getExperimentPair(const string & input) {
-	for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-		if (input == numericExperimentVector[i]->getTitle()) { return(pair<string, size_t>{"numeric", i }); }
-	}
-	for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-		if (input == stringExperimentVector[i]->getTitle()) { return(pair<string, size_t>{"string", i }); }
-	}
+// A function to find an experiments handle given its name
+experimentHandle mainMenu::getExperimentHandle(const string & input) {
+	experimentHandle handle;
+	if (experiments.find(input, handle)) { return(handle); }
 	cout << "Warning: Tried to find experiment that doesn't exist. Exiting program." << endl;
 	exit(1);
 }
 
 // A function to check if an experiment name already exists or not
 bool mainMenu::checkTitle(const string & input){
-	for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-		if (numericExperimentVector[i]->getTitle() == input) { return true; }
-	}
-	for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-		if (stringExperimentVector[i]->getTitle() == input) { return true; }
-	}
-	return false;
+	return (experiments.contains(input));
 }
 
 // A function to show the user all the experiments, and give more actions for them
 bool mainMenu::seeExperiments() {
 	bool keepRunning{ true };
-	pair<string, size_t> currentExperiment;
+	experimentHandle currentExperiment;
 	
-	if (numericExperimentVector.size() + stringExperimentVector.size() == 0) { 
+	if (experiments.size() == 0) { 
 		cout << "No experiments are currently being stored" << endl;
 		return (false);
 	}
@@ -115,20 +396,22 @@ bool mainMenu::seeExperiments() {
 	while (keepRunning) {
 		// Print out all experiments and show number of correlated measurements contained within each
 		cout << endl;
-		if (numericExperimentVector.size() != 0) {
+		vector<experiment<double>*> numericExperiments{ experiments.getNumericExperiments() };
+		vector<experiment<string>*> stringExperiments{ experiments.getStringExperiments() };
+		if (numericExperiments.size() != 0) {
 			cout << "# Numeric experiments #" << endl;
-			for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-				cout << numericExperimentVector[i]->getTitle();
-				size_t numCorrel{ numericExperimentVector[i]->getNumberOfCorrelated() };
+			for (size_t i{ 0 }; i < numericExperiments.size(); i++) {
+				cout << numericExperiments[i]->getTitle();
+				size_t numCorrel{ numericExperiments[i]->getNumberOfCorrelated() };
 				if (numCorrel != 0) { cout << " (" << numCorrel + 1 << ")"; }
 				cout << endl;
 			}
 		}
-		if (stringExperimentVector.size() != 0) {
+		if (stringExperiments.size() != 0) {
 			cout << "# String experiments #" << endl;
-			for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-				cout << stringExperimentVector[i]->getTitle();
-				size_t numCorrel{ stringExperimentVector[i]->getNumberOfCorrelated() };
+			for (size_t i{ 0 }; i < stringExperiments.size(); i++) {
+				cout << stringExperiments[i]->getTitle();
+				size_t numCorrel{ stringExperiments[i]->getNumberOfCorrelated() };
 				if (numCorrel != 0) { cout << " (" << numCorrel + 1 << ")"; }
 				cout << endl;
 			}
@@ -142,21 +425,7 @@ bool mainMenu::seeExperiments() {
 			string answer;
 			getline(cin, answer);
 			if (answer == "cancel") { return (false); }
-			if (!checkTitle(answer)) { cout << "Experiment not found, try again" << endl; foundExperiment = false; }
-			else {
-				for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-					if (numericExperimentVector[i]->getTitle() == answer) {
-						get<0>(currentExperiment) = "numeric";
-						get<1>(currentExperiment) = i;
-					}
-				}
-				for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-					if (stringExperimentVector[i]->getTitle() == answer) {
-						get<0>(currentExperiment) = "string";
-						get<1>(currentExperiment) = i;
-					}
-				}
-			}
+			if (!experiments.find(answer, currentExperiment)) { cout << "Experiment not found, try again" << endl; foundExperiment = false; }
 		} while (!foundExperiment);
 
 		cout << "What do you want to do with this experiment?" << endl;
@@ -180,28 +449,14 @@ bool mainMenu::seeExperiments() {
 		else if (answer == 3) {
 			// Allow user to give the name of the second experiment to correlate with
 			cout << "What experiment do you want to correlate this with? Or type 'cancel' to go back" << endl;
-			pair<string, size_t> secondExperiment;
+			experimentHandle secondExperiment;
 			bool foundExperiment;
 			do {
 				foundExperiment = true;
 				string answer;
 				getline(cin, answer);
 				if (answer == "cancel") { return (false); }
-				if (!checkTitle(answer)) { cout << "Experiment not found, try again" << endl; foundExperiment = false; }
-				else {
-					for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-						if (numericExperimentVector[i]->getTitle() == answer) {
-							get<0>(secondExperiment) = "numeric";
-							get<1>(secondExperiment) = i;
-						}
-					}
-					for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-						if (stringExperimentVector[i]->getTitle() == answer) {
-							get<0>(secondExperiment) = "string";
-							get<1>(secondExperiment) = i;
-						}
-					}
-				}
+				if (!experiments.find(answer, secondExperiment)) { cout << "Experiment not found, try again" << endl; foundExperiment = false; }
 			} while (!foundExperiment);
 			// Check for self correlation
 			if (currentExperiment == secondExperiment) { cout << "A function can't correlate with itself" << endl; return false; }
@@ -218,14 +473,11 @@ bool mainMenu::seeExperiments() {
 // A function to add an experiment either by file or by keyboard
 bool mainMenu::addExperiment() {
 	string experimentType, inputStyle, experimentTitle;
-	vector<string> measurements;
 
 	// Generally 2 types of input are expected: numeric and strings
 	// There is also the possibility of an input being "error", in which case the data is still recorded
-	// Define a set of counters which quantify what type of measurements are contained in the file or input via keyboard
-	// These counters and vector will be checked after to determine what type of experiment class to create
-	vector<size_t> counters{ 0,0,0 };
-	// Format: numeric counter, string counter, error counter
+	// Lines are read in to a new experiment with readDataText, which checks every line before the experiment is created
+	dataExtraction::dataFileResult result;
 
 	cout << "Do you want to input data from a file or the keyboard? (f/k)" << endl;
 	int tempInt{ testUserInput({ { "file","f" },{ "keyboard","key","k" },{ "cancel","exit" } }) };
@@ -259,7 +511,7 @@ bool mainMenu::addExperiment() {
 	if (inputStyle == "file") {
 		// Read data from file
 		string fileName;	// Variable to store name of the file
-		ifstream inputFile;	// File containing the data (Read only)
+		ifstream inputFile;	// Used to check the file exists
 
 		// Ask user for file name, and make sure file opens properly
 		do {
@@ -269,44 +521,14 @@ bool mainMenu::addExperiment() {
 			inputFile.open(path + fileName);
 			if (!inputFile.good()) { cout << "Could not open file. Try again." << endl; }
 		} while (!inputFile.good());
-		
-		// Loop through file getting all lines and storing them in a vector
-		while (!inputFile.eof()) {
-			string tempString;
-			getline(inputFile, tempString);
-			if (tempString.length() != 0) { measurements.push_back(tempString); }
-		}
 		inputFile.close();
-		
-		// Make iterators
-		vector<string>::const_iterator fileBegin{ measurements.begin() }, fileEnd{ measurements.end() }, fileCurrent;
-
-		// Check if all strings are valid, and check their types
-		for (fileCurrent = fileBegin; fileCurrent < fileEnd; ++fileCurrent) {
-			if (!dataExtraction::checkMeasurementType(*fileCurrent, counters)) {
-				// Detected an error
-				cout << "Warning: Invalid measurement found in '" << fileName << "'." << endl;
-				cout << "Exiting data input stage." << endl;
-				return(false);
-			}
-		}
-		// Check counters make sense: Either numeric or string, not both
-		if (counters[0] != 0 && counters[1] != 0) {
-			cout << "Warning: Inconsistant measurements found in '" << fileName << "'." << endl;
-			cout << "Mix of numeric and string inputs" << endl;
-			cout << "Exiting data input stage." << endl;
-			return(false);
-		}
-		else if (counters[0] == 0 && counters[1] == 0 && counters[2] == 0) {
-			cout << "Warning: Inconsistant measurements found in '" << fileName << "'." << endl;
-			cout << "No measurements found" << endl;
+
+		result = dataExtraction::readDataFile(path + fileName, experimentTitle);
+		if (!result.valid) {
+			cout << "Warning: " << result.message << " in '" << fileName << "'." << endl;
 			cout << "Exiting data input stage." << endl;
 			return(false);
 		}
-
-		// Set experiment type according to lines found
-		if (counters[0] != 0) { experimentType = "numeric"; }
-		else { experimentType = "string"; }
 	}
 	else {
 		// Read data from keyboard
@@ -321,139 +543,161 @@ bool mainMenu::addExperiment() {
 		cout << "You can also input error measurements. Just type 'error' followed by the timestamp" << endl;
 		cout << "Timestamps have the following format: YYYY/MM/DD hh:mm:ss" << endl;
 
-		// Take in data
-		string tempString;
+		// Take in data. Each line is checked as it is typed, and valid lines are kept as a block of text to be read like a file
+		string tempString, typedText;
+		vector<string_view> substrings;
+		dataExtraction::parsedDataLine parsedLine;
 		do {
 			cout << "Input measurement, or type finished" << endl;
 			getline(cin, tempString);
-			// Check if valid
-			if (!dataExtraction::checkMeasurementType(tempString, counters)) {
-				if (tempString != "finished") { cout << "Last measurement wasn't valid" << endl; }
-			}
-			else if (experimentType == "numeric" && counters[1] != 0) {
-				cout << "Last measurement wasn't valid" << endl;
-				counters[1] = 0;
-			}
-			else if (experimentType == "string" && counters[0] != 0) {
-				cout << "Last measurement wasn't valid" << endl;
-				counters[0] = 0;
-			}
-			else {
-				measurements.push_back(tempString);
-			}
+			if (tempString == "finished") { continue; }
+			// The text table refers to tempString, so a new one is used for each line
+			dataExtraction::dataTextTable texts;
+			bool valid{ dataExtraction::parseDataLine(tempString, substrings, texts, parsedLine) };
+			if (experimentType == "numeric" && parsedLine.type == dataExtraction::stringLine) { valid = false; }
+			if (experimentType == "string" && parsedLine.type == dataExtraction::numericLine) { valid = false; }
+			if (!valid) { cout << "Last measurement wasn't valid" << endl; }
+			else { typedText += tempString; typedText += '\n'; }
 		} while (tempString != "finished");
 
-		if (measurements.size() == 0) {
+		if (typedText.length() == 0) {
 			cout << "Warning: No measurements were input" << endl;
 			cout << "Exiting data input stage." << endl;
 			return(false);
 		}
+		result = dataExtraction::readDataText(typedText, experimentTitle, experimentType);
 	}
 
-	// Now we have finished reading in the data. Now create experiments
-	// Create either double or string experiment
-	if (experimentType == "numeric") {
-		experiment<double>* tempExp{ new experiment<double>{counters[0], counters[2], experimentTitle} };
-		numericExperimentVector.push_back(tempExp);
+	// Now we have finished reading in the data, add the experiment to the program
+	if (result.numericExp != NULL) {
+		result.numericExp->updateAccounting();
+		experiments.add(result.numericExp);
 	}
 	else {
-		experiment<string>* tempExp{ new experiment<string>{counters[1], counters[2], experimentTitle } };
-		stringExperimentVector.push_back(tempExp);
-	}
-
-	// Now create experiment with either file or keyboard input
-	// Now add measurements using a lambda function and iterators
-	// Make iterators
-	vector<string>::const_iterator vecStart{ measurements.begin() }, vecEnd{ measurements.end() };
-	// We need to record how many measurement have been put in to the experiment so far
-	size_t measurementCounter{ 0 }; size_t errorCounter{ 0 };
-	for_each(vecStart, vecEnd,
-		[experimentType, &measurementCounter, &errorCounter]
-	(string fullString)
-	{	
-		vector<string> substrings{ splitString(fullString) };
-		bool errorFound{ false };
-		// Check for error string
-		for (size_t i{ 0 }; i < substrings.size(); i++) {
-			if (substrings[i] == "error") { errorFound = true; }
-		}
-		if (errorFound) {
-			// Error measurement
-			measurement<string> tempMes{"error", "N/A", "N/A", "N/A", substrings.back() };
-			if (experimentType == "numeric") { 
-				numericExperimentVector.back()->getMeasurementError(errorCounter) = tempMes; 
-				numericExperimentVector.back()->getOrderVector().push_back(pair<string, size_t>{"error", errorCounter});
-			}
-			else { 
-				stringExperimentVector.back()->getMeasurementError(errorCounter) = tempMes;
-				stringExperimentVector.back()->getOrderVector().push_back(pair<string, size_t>{"error", errorCounter});
-			}
-			errorCounter++;
+		result.stringExp->updateAccounting();
+		experiments.add(result.stringExp);
+	}
+	cout << "A total of " << result.measurements + result.errors << " measurements have succesfully been input." << endl;
+
+	return (true);
+}
+
+// A function to add an experiment for each file in a list of data files, reading the files at the same time on several threads
+bool mainMenu::ingestFiles() {
+	string input;
+	vector<string> fileNames;
+	// Ask user for the files, and make sure every name matches a file
+	do {
+		cout << "Which data files do you want to add? Give the file names (including file extension) seperated by commas. Names can use"
+			<< " * and ? wildcards, for example 'run*.dat'. Or enter 'cancel' if you have changed your mind." << endl;
+		getline(cin, input);
+		if (input == "cancel") { return(false); }
+	} while (!dataExtraction::findDataFiles(input, fileNames));
+
+	// Read the files, with each thread taking the next file that hasn't been started
+	// The statistics threads are shared out between the files being read at once, so each file only gets the parser threads left over
+	// (1 when there are at least as many files as threads) rather than every file starting a full set of its own
+	size_t threadCount{ min(getStatisticsThreads(), fileNames.size()) };
+	size_t parserThreads{ max(getStatisticsThreads() / threadCount, size_t(1)) };
+	cout << "Reading " << fileNames.size() << " files on " << threadCount << " threads..." << endl;
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	vector<dataExtraction::dataFileResult> results(fileNames.size());
+	atomic<size_t> nextFile{ 0 };
+	auto worker = [&nextFile, &fileNames, &results, parserThreads]() {
+		for (size_t i{ nextFile++ }; i < fileNames.size(); i = nextFile++) {
+			results[i] = dataExtraction::readDataFile(path + fileNames[i], dataExtraction::titleFromFileName(fileNames[i]), parserThreads);
 		}
-		else if (experimentType == "numeric") {
-			// Numeric experiment
-			measurement<double> tempMes{stod(substrings[0]), stod(substrings[1]), stod(substrings[2]), substrings[3], substrings[4] };
-			numericExperimentVector.back()->getMeasurement(measurementCounter) = tempMes;
-			numericExperimentVector.back()->getOrderVector().push_back(pair<string, size_t>{"numeric", measurementCounter});
-			measurementCounter++;
+	};
+	// The current thread also reads files, so only threadCount - 1 extra threads are needed
+	vector<thread> threads;
+	for (size_t i{ 1 }; i < threadCount; i++) { threads.push_back(thread(worker)); }
+	worker();
+	for (size_t i{ 0 }; i < threads.size(); i++) { threads[i].join(); }
+	double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+
+	// Add the experiments in the order the files were listed. Titles are checked here, since the user may have to choose a new one
+	size_t filesAdded{ 0 }, measurementsAdded{ 0 }, bytesRead{ 0 };
+	bool cancelled{ false };
+	for (size_t i{ 0 }; i < results.size(); i++) {
+		dataExtraction::dataFileResult & result{ results[i] };
+		bytesRead += result.bytes;
+		if (!result.valid) { cout << fileNames[i] << ": not added. " << result.message << endl; continue; }
+		string title{ result.numericExp != NULL ? result.numericExp->getTitle() : result.stringExp->getTitle() };
+		if (!cancelled) { cancelled = !dataExtraction::chooseLoadTitle(title); }
+		if (cancelled) {
+			// The user stopped adding experiments, so the rest are deleted
+			if (result.numericExp != NULL) { delete result.numericExp; }
+			else { delete result.stringExp; }
+			continue;
+		}
+		if (result.numericExp != NULL) {
+			result.numericExp->setTitle(title);
+			result.numericExp->updateAccounting();
+			experiments.add(result.numericExp);
 		}
 		else {
-			// String experiment
-			measurement<string> tempMes{substrings[0], "N/A", "N/A", "N/A", substrings[1] };
-			stringExperimentVector.back()->getMeasurement(measurementCounter) = tempMes;
-			stringExperimentVector.back()->getOrderVector().push_back(pair<string, size_t>{"string", measurementCounter});
-			measurementCounter++;
+			result.stringExp->setTitle(title);
+			result.stringExp->updateAccounting();
+			experiments.add(result.stringExp);
 		}
-	});
-
-	cout << "A total of " << counters[0] + counters[1] + counters[2] << " measurements have succesfully been input." << endl;
+		cout << fileNames[i] << ": added as '" << title << "' (" << result.measurements << " measurements, " << result.errors
+			<< " errors)" << endl;
+		filesAdded++;
+		measurementsAdded += result.measurements + result.errors;
+	}
 
-	return (true);
+	// Tell the user how quickly the files were read
+	double megabytes{ double(bytesRead) / (1024. * 1024.) };
+	cout << "Added " << filesAdded << " of " << fileNames.size() << " files (" << measurementsAdded << " measurements, " << megabytes
+		<< " MB) in " << seconds << " s";
+	if (seconds > 0) { cout << " (" << megabytes / seconds << " MB/s, " << double(measurementsAdded) / seconds << " measurements/s)"; }
+	cout << endl;
+	return (filesAdded != 0);
 }
 
 // A function to delete a given experiment and its correlated experiments
-bool mainMenu::deletExperiment(const pair<string, size_t>& exp){
+bool mainMenu::deletExperiment(const experimentHandle & exp){
 
-	if (get<0>(exp) == "numeric") {
+	if (exp.type == numericExperiment) {
 		// Numeric experiment
-		delete numericExperimentVector[get<1>(exp)];
-		numericExperimentVector.erase(numericExperimentVector.begin() + get<1>(exp));
+		journal::forgetExperiment(experiments.getNumeric(exp));
 	}
 	else {
 		// String experiment
-		delete stringExperimentVector[get<1>(exp)];
-		stringExperimentVector.erase(stringExperimentVector.begin() + get<1>(exp));
+		journal::forgetExperiment(experiments.getString(exp));
 	}
 
-	return true;
+	return (experiments.remove(exp));
 }
 
 // A function to generate a report for an experiment to file or screen
 // Do this by collecting a string stream and then printing this to screen or file depending on user input
-bool mainMenu::makeReport(const pair<string, size_t> & index) {
+bool mainMenu::makeReport(const experimentHandle & index) {
 	// Ask user if they want to print the report to a file or a screen
 	cout << "Do you want to print the report to the screen, or to a file? (s/f). Or type 'cancel' to go back." << endl;
 	int answer{ testUserInput({{"screen","s"},{"file","f"},{"cancel","c"}}) };
 	if (answer == 2) { return false; }
 	stringstream ss;
-	if (index == pair<string, size_t>{"null", 0}) {
+	if (index == noExperiment) {
 		// All experiments must be in the report
-		for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-			ss << numericExperimentVector[i]->makeReport(0).str();
+		vector<experiment<double>*> numericExperiments{ experiments.getNumericExperiments() };
+		vector<experiment<string>*> stringExperiments{ experiments.getStringExperiments() };
+		for (size_t i{ 0 }; i < numericExperiments.size(); i++) {
+			ss << numericExperiments[i]->makeReport(0).str();
 			ss << endl  << "#################################################" << endl << endl;
 		}
-		for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-			ss << stringExperimentVector[i]->makeReport(0).str();
+		for (size_t i{ 0 }; i < stringExperiments.size(); i++) {
+			ss << stringExperiments[i]->makeReport(0).str();
 			ss << endl << "#################################################" << endl << endl;
 		}
 	}
 	else {
 		// Only one experiment must be in the report
-		if (get<0>(index) == "numeric") {
-			ss = numericExperimentVector[get<1>(index)]->makeReport(0);
+		if (index.type == numericExperiment) {
+			ss = experiments.getNumeric(index)->makeReport(0);
 		}
-		else if (get<0>(index) == "string") {
-			ss = stringExperimentVector[get<1>(index)]->makeReport(0);
+		else {
+			ss = experiments.getString(index)->makeReport(0);
 		}
 	}
 	if (answer == 0) { 
@@ -514,12 +758,19 @@ bool mainMenu::makeReport(const pair<string, size_t> & index) {
 // Function to save data in a file named by the user
 bool mainMenu::saveData(){
 	// Check if any experiments are in the program
-	if (numericExperimentVector.size() + stringExperimentVector.size() == 0) {
+	if (experiments.size() == 0) {
 		cout << "No experiments are currently being stored" << endl;
 		return (false);
 	}
 	string saveName;
 	bool validName;
+	// Ask user for the format of the save file
+	cout << "Do you want to save as text, in the smaller and faster binary format, or as a journal which only adds the changes since"
+		<< " it was last saved? (t/b/j). Or type 'cancel' to go back." << endl;
+	int format{ testUserInput({ { "text","t" },{ "binary","b" },{ "journal","j" },{ "cancel","c" } }) };
+	if (format == 3) { return(false); }
+	bool binary{ format == 1 };
+	bool isJournal{ format == 2 };
 	// Ask user for name of save file
 	cout << "What do you want to name your save file? Or type cancel to return to the main menu." << endl;
 	do {
@@ -527,24 +778,18 @@ bool mainMenu::saveData(){
 		if (saveName == "cancel") { return(false); }
 		if (saveName.length() == 0) { cout << "Empty names are not valid" << endl; validName = false; }
 		else {
-			saveName = "SAV_" + saveName + ".dat";
+			saveName = "SAV_" + saveName + (isJournal ? ".jnl" : (binary ? ".bin" : ".dat"));
 			validName = true;
 			// Try to open file with corresponding name to see if it already exists
+			// The journal last saved or loaded is added to rather than overwritten, so there is no need to ask
 			ifstream saveFile;
 			saveFile.open(path+saveName);
-			if (saveFile.good()) {
+			if (saveFile.good() && !(isJournal && path + saveName == journal::fileName)) {
 				cout << "File already exists, do you want to overwrite it? (y/n)" << endl;
-				if (testUserInput({ { "yes","y" },{ "no","n" } }) == 0) {
-					// Overwrite file
-					saveFile.close();
-					if (remove((path + saveName).c_str()) != 0) {
-						cout << "Could not overwrite file. Enter a new name, Or type 'cancel' to return to the main menu." << endl;
-						validName = false;
-					}
-				}
-				else {
-					// Close file and ask for new name
-					saveFile.close();
+				// The old file is only replaced once the new one is complete, so it isn't deleted here
+				saveFile.close();
+				if (testUserInput({ { "yes","y" },{ "no","n" } }) == 1) {
+					// Ask for new name
 					cout << "Enter a new name, or type 'cancel' to return to the main menu" << endl;
 					validName = false;
 				}
@@ -552,148 +797,93 @@ bool mainMenu::saveData(){
 		}
 	} while (!validName);
 
-	// Now create save file
-	// Open file
-	ofstream saveFile{path+saveName};
+	// Only one save runs in the background at a time
+	if (backgroundSave.valid()) {
+		cout << "Waiting for the previous background save to finish..." << endl;
+		checkBackgroundSave(true);
+	}
 
-	if (!saveFile.good()) { cout << "File could not be created, returning to main menu" << endl; return (false); }
-	// Loop through experiments creating the appropriate code in the save file
-	for (size_t i{ 0 }; i < numericExperimentVector.size(); i++) {
-		saveFile << numericExperimentVector[i]->getSaveFileStream().str();
+	// Journals only write the changes since the last save, so they are always saved straight away
+	if (isJournal) {
+		dataExtraction::saveResult result{ journal::saveJournal(path + saveName) };
+		dataExtraction::printSaveResult(saveName, result);
+		return (result.written);
 	}
-	for (size_t i{ 0 }; i < stringExperimentVector.size(); i++) {
-		saveFile << stringExperimentVector[i]->getSaveFileStream().str();
+
+	if (!backgroundSaves) {
+		// Write every experiment in the chosen format
+		dataExtraction::saveResult result{ dataExtraction::writeSaveFile(path + saveName, binary, experiments.getNumericExperiments(),
+			experiments.getStringExperiments()) };
+		dataExtraction::printSaveResult(saveName, result);
+		return (result.written);
 	}
+
+	// Copy the experiments so they can be changed or deleted while the copy is written in the background
+	vector<experiment<double>*> numericCopies{ experiments.getNumericExperiments() };
+	vector<experiment<string>*> stringCopies{ experiments.getStringExperiments() };
+	for (size_t i{ 0 }; i < numericCopies.size(); i++) { numericCopies[i] = dataExtraction::copyForSave(numericCopies[i]); }
+	for (size_t i{ 0 }; i < stringCopies.size(); i++) { stringCopies[i] = dataExtraction::copyForSave(stringCopies[i]); }
+	string fileName{ path + saveName };
+	backgroundSaveName = saveName;
+	backgroundSave = async(launch::async, [fileName, binary, numericCopies, stringCopies]() {
+		dataExtraction::saveResult result{ dataExtraction::writeSaveFile(fileName, binary, numericCopies, stringCopies) };
+		for (size_t i{ 0 }; i < numericCopies.size(); i++) { delete numericCopies[i]; }
+		for (size_t i{ 0 }; i < stringCopies.size(); i++) { delete stringCopies[i]; }
+		return (result);
+	});
+	cout << "Saving to '" << saveName << "' in the background" << endl;
 	return (true);
 }
 
+// A function to check if a background save has finished, telling the user the result
+void mainMenu::checkBackgroundSave(const bool & wait) {
+	if (!backgroundSave.valid()) { return; }
+	if (!wait && backgroundSave.wait_for(chrono::seconds(0)) != future_status::ready) { return; }
+	dataExtraction::saveResult result{ backgroundSave.get() };
+	cout << "Background save: ";
+	dataExtraction::printSaveResult(backgroundSaveName, result);
+}
+
 // A function to load a save file of data
 bool mainMenu::loadData(){
 	// Find save file
 	string fileName;	// Variable to store name of the file
-	ifstream inputFile;	// File containing the data (Read only)
+	mappedFile inputFile;	// File containing the data (Read only, mapped in to memory so it can be read in place)
 
 	// Ask user for file name, and make sure file opens properly
 	do {
 		cout << "What is the name of your save file? Or enter 'cancel' if you have changed your mind." << endl;
 		getline(cin, fileName);
 		if (fileName == "cancel") { return(false); }
-		fileName = "SAV_" + fileName + ".dat";
-		inputFile.open(path+fileName);
-		if (!inputFile.good()) { cout << "Could not open file. Try again." << endl; }
-	} while (!inputFile.good());
-
-	string fileLine;
-	vector<string> substrings;
-	bool validTitle;
-	// Now copy data from save file
-	while (!inputFile.eof()) {
-		do {
-			getline(inputFile, fileLine);
-		} while (fileLine.length() == 0 && !inputFile.eof());
-		substrings = splitString(fileLine);
-
-		// Check for correlation line
-		if (substrings[0] == "correlate") {
-			correlate(getExperimentPair(substrings[1]), getExperimentPair(substrings[2]), false);
-		}
-
-		// Check for numeric experiment line
-		if (fileLine == "NUMERIC_EXPERIMENT_BEGIN") {
-			getline(inputFile, fileLine);
-			substrings = splitString(fileLine);
-			// Check if title already exists
-			do {
-				validTitle = true;
-				// Check if user has said to cancel process. Note this is safe since no experiment could ever have name 'cancel'
-				if (substrings[0] == "cancel") { return(false); }
-				if (checkTitle(substrings[0])) {
-					cout << "You are trying to load an experiment with a name that already exists: " << substrings[0] << endl;
-					cout << "Please input a new name, or type 'cancel' to stop loading in experiments." << endl;
-					getline(cin, substrings[0]);
-					validTitle = false;
-				}
-			} while (!validTitle);
-
-			// Create new experiment
-			experiment<double>* tempExp{ new experiment<double>{size_t(stoi(substrings[1])),size_t(stoi(substrings[2])),substrings[0]} };
-			// Create counters to keep track of all measurements currently loaded in
-			size_t measurementCounter{ 0 }; size_t errorCounter{ 0 };
-			getline(inputFile, fileLine);
-			substrings = splitString(fileLine);
-			while (fileLine != "NUMERIC_EXPERIMENT_END") {
-				if (isStringNum(substrings[0])) {
-					// Numeric measurement
-					measurement<double> tempMes{stod(substrings[0]),stod(substrings[1]),stod(substrings[2]),substrings[3],substrings[4] };
-					tempExp->getMeasurement(measurementCounter) = tempMes;
-					tempExp->getOrderVector().push_back(pair<string, size_t>{"numeric", measurementCounter});
-					measurementCounter++;
-				}
-				else {
-					// Error measurement
-					measurement<string> tempMes{ substrings[0], "N/A", "N/A", "N/A", substrings.back() };
-					tempExp->getMeasurementError(errorCounter) = tempMes;
-					tempExp->getOrderVector().push_back(pair<string, size_t>{"error", errorCounter});
-					errorCounter++;
-				}
-				getline(inputFile, fileLine);
-				substrings = splitString(fileLine);
-			}
-			numericExperimentVector.push_back(tempExp);
-		}
-		else if (fileLine == "STRING_EXPERIMENT_BEGIN") {
-			getline(inputFile, fileLine);
-			substrings = splitString(fileLine);
-
-			// Check if title already exists
-			do {
-				validTitle = true;
-				if (substrings[0] == "cancel") { return(false); }
-				if (checkTitle(substrings[0])) {
-					cout << "You are trying to load an experiment with a name that already exists: " << substrings[0] << endl;
-					cout << "Please input a new name, or type 'cancel' to stop loading in experiments." << endl;
-					getline(cin, substrings[0]);
-					validTitle = false;
-				}
-			} while (!validTitle);
-
-			// Create new experiment
-			experiment<string>* tempExp{ new experiment<string>{size_t(stoi(substrings[1])),size_t(stoi(substrings[2])),substrings[0] } };
-			// Create counters to keep track of all measurements currently loaded in
-			size_t measurementCounter{ 0 }; size_t errorCounter{ 0 };
-			getline(inputFile, fileLine);
-			substrings = splitString(fileLine);
-			while (fileLine != "STRING_EXPERIMENT_END") {
-				// String and error measurements
-				measurement<string> tempMes{substrings[0], "N/A", "N/A", "N/A", substrings.back() };
-				if (substrings[0] != "error") { 
-					tempExp->getMeasurement(measurementCounter) = tempMes;
-					tempExp->getOrderVector().push_back(pair<string, size_t>{"string", measurementCounter});
-					measurementCounter++;
-				}
-				else { 
-					tempExp->getMeasurementError(errorCounter) = tempMes;
-					tempExp->getOrderVector().push_back(pair<string, size_t>{"error", errorCounter});
-					errorCounter++;
-				}
-				getline(inputFile, fileLine);
-				substrings = splitString(fileLine);
-			}
-			stringExperimentVector.push_back(tempExp);
-		}
-	}
+		if (!dataExtraction::openSaveFile(fileName, inputFile, fileName)) { cout << "Could not open file. Try again." << endl; }
+	} while (!inputFile.isOpen());
+
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	string_view fileData{ inputFile.getData(), inputFile.getSize() };
+	// Read the file in whichever format it was saved in
+	bool valid;
+	if (journal::isJournalFile(fileData)) { valid = journal::loadJournalFile(fileData, path + fileName, true); }
+	else if (dataExtraction::isBinarySaveFile(fileData)) { valid = dataExtraction::loadBinarySaveFile(fileData); }
+	else { valid = dataExtraction::loadTextSaveFile(fileData); }
+	if (!valid) { return(false); }
+
+	// Tell the user how quickly the file was read
+	double seconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+	double megabytes{ double(inputFile.getSize()) / (1024. * 1024.) };
+	cout << "Loaded " << megabytes << " MB in " << seconds << " s";
+	if (seconds > 0) { cout << " (" << megabytes / seconds << " MB/s)"; }
+	cout << endl;
 	return true;
 }
 
 // A function to change the name of an experiment
-bool mainMenu::rename(const pair<string, size_t> & currentExperiment){
+bool mainMenu::rename(const experimentHandle & currentExperiment){
 	bool validTitle;
 	string newTitle;
 	string currentTitle;
 
 	// find current title
-	if (get<0>(currentExperiment) == "numeric") { currentTitle = numericExperimentVector[get<1>(currentExperiment)]->getTitle(); }
-	else { currentTitle = stringExperimentVector[get<1>(currentExperiment)]->getTitle(); }
+	currentTitle = experiments.getTitle(currentExperiment);
 
 	// Ask user for valid title
 	do {
@@ -707,8 +897,8 @@ bool mainMenu::rename(const pair<string, size_t> & currentExperiment){
 	} while (!validTitle);
 
 	// Set new title
-	if (get<0>(currentExperiment) == "numeric") { numericExperimentVector[get<1>(currentExperiment)]->setTitle(newTitle); }
-	else { stringExperimentVector[get<1>(currentExperiment)]->setTitle(newTitle); }
+	if (currentExperiment.type == numericExperiment) { experiments.rename(experiments.getNumeric(currentExperiment), newTitle); }
+	else { experiments.rename(experiments.getString(currentExperiment), newTitle); }
 
 	return (true);
 }
@@ -717,32 +907,30 @@ bool mainMenu::rename(const pair<string, size_t> & currentExperiment){
 // A function that allows experiments to be correlated, for example temperature and pressure measurements.
 // Order matters in this process. Exp2 will be stored inside of Exp1, with the idea that Exp1 is the independent variable
 // The check order variable is there so when correlation happens from load function it won't ask the user questions
-bool mainMenu::correlate(const pair<string, size_t>& exp1, const pair<string, size_t>& exp2, const bool & checkOrder){
+bool mainMenu::correlate(const experimentHandle & exp1, const experimentHandle & exp2, const bool & checkOrder){
 	// Need to check the experiments have a 1:1 correspondance
 	size_t mes1, err1, mes2, err2;	// Counters for the number of measurements and errors in exp1 and exp2 respectively
 	string firstTitle, secondTitle;	// Name of first and second experiment respectively
 
 	// find all counter values and experiment names
-	if (get<0>(exp1) == "numeric") {
-		mes1 = numericExperimentVector[get<1>(exp1)]->getMeasurementCounter();
-		err1 = numericExperimentVector[get<1>(exp1)]->getErrorCounter();
-		firstTitle = numericExperimentVector[get<1>(exp1)]->getTitle();
+	if (exp1.type == numericExperiment) {
+		mes1 = experiments.getNumeric(exp1)->getMeasurementCounter();
+		err1 = experiments.getNumeric(exp1)->getErrorCounter();
 	}
 	else {
-		mes1 = stringExperimentVector[get<1>(exp1)]->getMeasurementCounter();
-		err1 = stringExperimentVector[get<1>(exp1)]->getErrorCounter();
-		firstTitle = stringExperimentVector[get<1>(exp1)]->getTitle();
+		mes1 = experiments.getString(exp1)->getMeasurementCounter();
+		err1 = experiments.getString(exp1)->getErrorCounter();
 	}
-	if (get<0>(exp2) == "numeric") {
-		mes2 = numericExperimentVector[get<1>(exp2)]->getMeasurementCounter();
-		err2 = numericExperimentVector[get<1>(exp2)]->getErrorCounter();
-		secondTitle = numericExperimentVector[get<1>(exp2)]->getTitle();
+	if (exp2.type == numericExperiment) {
+		mes2 = experiments.getNumeric(exp2)->getMeasurementCounter();
+		err2 = experiments.getNumeric(exp2)->getErrorCounter();
 	}
 	else {
-		mes2 = stringExperimentVector[get<1>(exp2)]->getMeasurementCounter();
-		err2 = stringExperimentVector[get<1>(exp2)]->getErrorCounter();
-		secondTitle = stringExperimentVector[get<1>(exp2)]->getTitle();
+		mes2 = experiments.getString(exp2)->getMeasurementCounter();
+		err2 = experiments.getString(exp2)->getErrorCounter();
 	}
+	firstTitle = experiments.getTitle(exp1);
+	secondTitle = experiments.getTitle(exp2);
 	// Check if there is a 1:1 ratio
 	if (mes1 + err1 != mes2 + err2) { 
 		cout << "Experiments cannot be correlated, they don't have a 1:1 correspondance of measurements" << endl; 
@@ -770,41 +958,132 @@ bool mainMenu::correlate(const pair<string, size_t>& exp1, const pair<string, si
 		}
 	}
 
-	// Now put the pointer to second experiment into the correlation vector in first experiment,
-	// and remove the pointer from the numeric/stringExperimentVector
-	// If experiment 1 is numeric
-	if (get<0>(exp1) == "numeric") {
-		experiment<double>* firstExp{ numericExperimentVector[get<1>(exp1)] };
-		if (get<0>(exp2) == "numeric") {
-			experiment<double>* secondExp{ numericExperimentVector[get<1>(exp2)] };
-			firstExp->getNumericCorrelatedVector().push_back(secondExp);
-			numericExperimentVector.erase(numericExperimentVector.begin() + get<1>(exp2));
-		}
-		else if (get<0>(exp2) == "string") {
-			experiment<string>* secondExp{ stringExperimentVector[get<1>(exp2)] };
-			firstExp->getStringCorrelatedVector().push_back(secondExp);
-			stringExperimentVector.erase(stringExperimentVector.begin() + get<1>(exp2));
-		}
-	}
-	// If experiment 1 is string
-	else if (get<0>(exp1) == "string"){
-		experiment<string>* firstExp{ stringExperimentVector[get<1>(exp1)] };
-		if (get<0>(exp2) == "numeric") {
-			experiment<double>* secondExp{ numericExperimentVector[get<1>(exp2)] };
-			firstExp->getNumericCorrelatedVector().push_back(secondExp);
-			numericExperimentVector.erase(numericExperimentVector.begin() + get<1>(exp2));
-		}
-		else if (get<0>(exp2) == "string") {
-			experiment<string>* secondExp{ stringExperimentVector[get<1>(exp2)] };
-			firstExp->getStringCorrelatedVector().push_back(secondExp);
-			stringExperimentVector.erase(stringExperimentVector.begin() + get<1>(exp2));
-		}
-	}
+	// Now move the second experiment in to the correlation vector of the first experiment. The registry no longer holds it by itself,
+	// and its title (and those of its correlated experiments) now point to the first experiment
+	experiments.correlate(exp1, exp2);
 
 	// If succesful return true
 	return true;
 }
 
+// A function to let the user change the settings of the program, such as the number of threads used for statistics
+bool mainMenu::changeSettings() {
+	// Show current settings
+	cout << "Current settings:" << endl;
+	cout << "Threads used for statistics: " << getStatisticsThreads() << " (Using " << getStatisticsKernelName() << " instructions)" << endl;
+	cout << "Save in the background: " << (backgroundSaves ? "on" : "off") << endl;
+	cout << "Bins in the distribution of numeric experiments: " << getHistogramBins() << " (" 
+		<< getBinningName(getHistogramBinning()) << ")" << endl;
+	cout << "Size of the quantile sketches of numeric experiments: " << getSketchSize() << endl;
+	cout << endl << "Which setting do you want to change? (threads/background/bins/sketch) Or type 'cancel' to go back." << endl;
+	int answer{ testUserInput({ { "threads","t" },{ "background","b" },{ "bins" },{ "sketch","s" },{ "cancel","c" } }) };
+	if (answer == 4) { return (false); }
+
+	if (answer == 3) {
+		// Bigger sketches give more accurate medians and percentiles, but use more memory. Sketches are rebuilt at the next report
+		string input;
+		size_t size;
+		bool validInput;
+		cout << "How many values should the quantile sketches keep at their top level? (200 gives percentiles to within about 1.5%)" << endl;
+		do {
+			getline(cin, input);
+			validInput = stringToSize(input, size) && size >= 8 && size < 1000000;
+			if (!validInput) { cout << "Input not valid. Try again:" << endl; }
+		} while (!validInput);
+		setSketchSize(size);
+	}
+
+	if (answer == 2) {
+		// Ask for a positive whole number of bins, then how they are chosen
+		string input;
+		size_t bins;
+		bool validInput;
+		cout << "How many bins should the distribution of numeric experiments have?" << endl;
+		do {
+			getline(cin, input);
+			validInput = stringToSize(input, bins) && bins > 0 && bins < 100000;
+			if (!validInput) { cout << "Input not valid. Try again:" << endl; }
+		} while (!validInput);
+		cout << "Should the bins have a fixed width, hold equal numbers of values, or have a fixed width in the log of the values?"
+			<< " (fixed/quantile/log)" << endl;
+		int binning{ testUserInput({ { "fixed","f" },{ "quantile","q" },{ "log","l" } }) };
+		setHistogramBins(bins, binning == 1 ? quantileBins : (binning == 2 ? logBins : fixedBins));
+	}
+
+	if (answer == 1) {
+		// Background saves copy the experiments first, so they need enough memory for a second copy of all the data
+		cout << "Do you want to save in the background? This needs memory for a copy of all the experiments. (y/n)" << endl;
+		backgroundSaves = testUserInput({ { "yes","y" },{ "no","n" } }) == 0;
+	}
+
+	if (answer == 0) {
+		// Ask for a positive whole number of threads
+		string input;
+		size_t threads;
+		bool validInput;
+		cout << "How many threads should be used for statistics?" << endl;
+		do {
+			getline(cin, input);
+			validInput = stringToSize(input, threads) && threads > 0 && threads < 10000;
+			if (!validInput) { cout << "Input not valid. Try again:" << endl; }
+		} while (!validInput);
+		setStatisticsThreads(threads);
+	}
+	return (true);
+}
+
+
+// A function to convert a save file from text to binary, or from binary to text. Journals are converted to binary
+// The file is loaded in to an empty registry, so the experiments already in the program are left alone
+bool mainMenu::convertSaveFile() {
+	string fileName, newName;
+	mappedFile inputFile;
+
+	// Ask user for file name, and make sure file opens properly
+	do {
+		cout << "What is the name of the save file to convert? Or enter 'cancel' if you have changed your mind." << endl;
+		getline(cin, fileName);
+		if (fileName == "cancel") { return(false); }
+		if (!dataExtraction::openSaveFile(fileName, inputFile, fileName)) { cout << "Could not open file. Try again." << endl; }
+	} while (!inputFile.isOpen());
+	string_view fileData{ inputFile.getData(), inputFile.getSize() };
+	// Journals are converted to binary, since the binary format is the same as their snapshot
+	bool isJournal{ journal::isJournalFile(fileData) };
+	bool toBinary{ isJournal || !dataExtraction::isBinarySaveFile(fileData) };
+	newName = fileName.substr(0, fileName.size() - 4) + (toBinary ? ".bin" : ".dat");
+
+	// Check before overwriting an existing file
+	ifstream existingFile{ path + newName };
+	if (existingFile.good()) {
+		cout << "File '" << newName << "' already exists, do you want to overwrite it? (y/n)" << endl;
+		if (testUserInput({ { "yes","y" },{ "no","n" } }) == 1) { return(false); }
+	}
+	existingFile.close();
+
+	// Swap the loaded experiments out while the file is converted
+	experimentRegistry loaded;
+	experiments.swap(loaded);
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	bool valid;
+	if (isJournal) { valid = journal::loadJournalFile(fileData, fileName, false); }
+	else { valid = toBinary ? dataExtraction::loadTextSaveFile(fileData) : dataExtraction::loadBinarySaveFile(fileData); }
+	double loadSeconds{ chrono::duration<double>(chrono::steady_clock::now() - startTime).count() };
+	dataExtraction::saveResult result{ false, 0, 0 };
+	if (valid) {
+		result = dataExtraction::writeSaveFile(path + newName, toBinary, experiments.getNumericExperiments(),
+			experiments.getStringExperiments());
+		valid = result.written;
+		if (!valid) { dataExtraction::printSaveResult(newName, result); }
+	}
+	// Swap the loaded experiments back, and delete the converted ones
+	experiments.swap(loaded);
+	loaded.clear();
+	if (!valid) { return(false); }
+
+	cout << "Converted '" << fileName << "' (" << double(inputFile.getSize()) / (1024. * 1024.) << " MB, read in " << loadSeconds
+		<< " s) to '" << newName << "' (" << double(result.bytes) / (1024. * 1024.) << " MB, written in " << result.seconds << " s)" << endl;
+	return (true);
+}
 
 // ##################### //
 // #  DATA EXTRACTION  # //
@@ -813,27 +1092,1157 @@ bool mainMenu::correlate(const pair<string, size_t>& exp1, const pair<string, si
 // A function to take the first input of measurement from the file and check its type
 // Will return false if error was found (Empty vectors, inconsistant vectors, etc...)
 bool mainMenu::dataExtraction::checkMeasurementType(const string & input, vector<size_t> & counters) {
-	vector<string> substrings{ splitString(input) };
+	vector<string_view> substrings;
+	dataTextTable texts;
+	parsedDataLine parsedLine;
+	if (!parseDataLine(input, substrings, texts, parsedLine)) { return (false); }
+	counters[parsedLine.type]++;
+	return (true);
+}
+
+// A function to find the position of a text in a text table, adding it if it is new
+uint32_t mainMenu::dataExtraction::findDataText(string_view text, dataTextTable & table) {
+	// Most lines have the same unit as the line before, so check the last text first
+	if (!table.texts.empty() && table.texts.back() == text) { return (uint32_t(table.texts.size() - 1)); }
+	unordered_map<string_view, uint32_t>::iterator found{ table.positions.find(text) };
+	if (found != table.positions.end()) { return (found->second); }
+	table.positions.emplace(text, uint32_t(table.texts.size()));
+	table.texts.push_back(text);
+	return (uint32_t(table.texts.size() - 1));
+}
+
+// A function to check and convert one line of a data file in a single pass
+bool mainMenu::dataExtraction::parseDataLine(string_view line, vector<string_view> & substrings, dataTextTable & texts,
+	parsedDataLine & output) {
+	splitStringView(line, substrings);
 	// Does measurement have a valid timestamp?
-	if (!timestamp::validTimeStamp(substrings.back())) { return (false); }
+	timestamp time;
+	if (!timestamp::parseTimeStamp(substrings.back(), time)) { return (false); }
+	output.packedDate = time.getPackedDate();
 	// Is input numeric, string or error?
 	// Check error first
 	for (size_t i{ 0 }; i < substrings.size(); i++) {
-		if (makeLowerCase(substrings[i]) == "error") { counters[2]++; return (true); }
+		if (equalsLowerCase(substrings[i], "error")) { output.type = errorLine; return (true); }
 	}
 	// Check numeric type
-	if (isStringNum(substrings[0])) {
+	if (stringToDouble(substrings[0], output.value)) {
 		// Is measurement valid? Need 5 entries (value, error, systError, unit, time)
 		// First 3 should be numeric (First already checked)
-		if (substrings.size() != 5) { return (false); }
-		if (!isStringNum(substrings[1]) || !isStringNum(substrings[2])) { return (false); }
-		counters[0]++;
+		if (substrings.size() != 5 || !stringToDouble(substrings[1], output.error) || !stringToDouble(substrings[2], output.systError)) {
+			return (false);
+		}
+		output.text = findDataText(substrings[3], texts);
+		output.type = numericLine;
 		return (true);
 	}
 	// If none of previous are true, must be general string
 	// For general string expect only value and timestamp
 	if (substrings.size() != 2) { return (false); }
-	counters[1]++; return (true);	// String type
+	output.text = findDataText(substrings[0], texts);
+	output.type = stringLine;
+	return (true);
+}
+
+// A function to check and convert one line of a numeric experiment in a text save file
+bool mainMenu::dataExtraction::parseNumericSaveLine(string_view line, vector<string_view> & substrings, dataTextTable & texts,
+	parsedDataLine & output) {
+	splitStringView(line, substrings);
+	timestamp time;
+	if (stringToDouble(substrings[0], output.value)) {
+		// Numeric measurement
+		if (substrings.size() != 5 || !stringToDouble(substrings[1], output.error) || !stringToDouble(substrings[2], output.systError)
+			|| !timestamp::parseTimeStamp(substrings[4], time)) { return(false); }
+		output.text = findDataText(substrings[3], texts);
+		output.type = numericLine;
+	}
+	else {
+		// Error measurement
+		if (!timestamp::parseTimeStamp(substrings.back(), time)) { return(false); }
+		output.type = errorLine;
+	}
+	output.packedDate = time.getPackedDate();
+	return(true);
+}
+
+// A function to check and convert one line of a string experiment in a text save file
+bool mainMenu::dataExtraction::parseStringSaveLine(string_view line, vector<string_view> & substrings, dataTextTable & texts,
+	parsedDataLine & output) {
+	splitStringView(line, substrings);
+	timestamp time;
+	if (!timestamp::parseTimeStamp(substrings.back(), time)) { return(false); }
+	output.packedDate = time.getPackedDate();
+	// String and error measurements
+	if (substrings[0] != "error") {
+		output.text = findDataText(substrings[0], texts);
+		output.type = stringLine;
+	}
+	else { output.type = errorLine; }
+	return(true);
+}
+
+// A function to check and convert every line of a chunk, stopping at the first line that isn't valid
+void mainMenu::dataExtraction::parseDataChunk(string_view chunk, const lineParser & parseLine, parsedDataBatch & output) {
+	output.bytes = chunk.size();
+	// Lines are rarely shorter than 16 characters, so this is enough space for most chunks
+	output.lines.reserve(chunk.size() / 16 + 1);
+	vector<string_view> substrings;
+	parsedDataLine parsedLine;
+	size_t position{ 0 };
+	string_view line;
+	while (getNextLine(chunk, position, line)) {
+		output.lineCount++;
+		if (line.length() == 0) { continue; }
+		if (!parseLine(line, substrings, output.texts, parsedLine)) {
+			output.invalidLine = output.lineCount;
+			output.invalidText = line;
+			return;
+		}
+		output.counters[parsedLine.type]++;
+		output.lines.push_back(parsedLine);
+	}
+}
+
+// A function to add the lines of a batch to a numeric experiment
+void mainMenu::dataExtraction::addParsedLines(const parsedDataBatch & batch, experiment<double>* exp) {
+	for (size_t i{ 0 }; i < batch.lines.size(); i++) {
+		const parsedDataLine & current{ batch.lines[i] };
+		if (current.type == errorLine) { exp->addMeasurementError(timestamp::fromPackedDate(current.packedDate)); }
+		else {
+			exp->addMeasurement(current.value, current.error, current.systError, batch.texts.texts[current.text],
+				timestamp::fromPackedDate(current.packedDate));
+		}
+	}
+}
+
+// A function to add the lines of a batch to a string experiment
+void mainMenu::dataExtraction::addParsedLines(const parsedDataBatch & batch, experiment<string>* exp) {
+	for (size_t i{ 0 }; i < batch.lines.size(); i++) {
+		const parsedDataLine & current{ batch.lines[i] };
+		if (current.type == errorLine) { exp->addMeasurementError(timestamp::fromPackedDate(current.packedDate)); }
+		else {
+			exp->addMeasurement(string(batch.texts.texts[current.text]), "N/A", "N/A", "N/A",
+				timestamp::fromPackedDate(current.packedDate));
+		}
+	}
+}
+
+// A function to check the title of an experiment being loaded is new, asking the user for a new one if not
+bool mainMenu::dataExtraction::chooseLoadTitle(string & title) {
+	bool validTitle;
+	do {
+		validTitle = true;
+		// Check if user has said to cancel process. Note this is safe since no experiment could ever have name 'cancel'
+		if (title == "cancel") { return(false); }
+		if (checkTitle(title)) {
+			cout << "You are trying to load an experiment with a name that already exists: " << title << endl;
+			cout << "Please input a new name, or type 'cancel' to stop loading in experiments." << endl;
+			getline(cin, title);
+			validTitle = false;
+		}
+	} while (!validTitle);
+	return(true);
+}
+
+// A function to read a data file in to a new experiment, which isn't added to the program
+mainMenu::dataExtraction::dataFileResult mainMenu::dataExtraction::readDataFile(const string & fileName, const string & title,
+	const size_t & threads) {
+	mappedFile inputFile;
+	if (!inputFile.open(fileName)) { return(dataFileResult{ false, "Could not open file", NULL, NULL, 0, 0, 0 }); }
+	dataFileResult result{ readDataText(string_view{ inputFile.getData(), inputFile.getSize() }, title, "", threads) };
+	result.bytes = inputFile.getSize();
+	return(result);
+}
+
+// A function to read lines of data in to a new experiment, checking and converting each line once
+mainMenu::dataExtraction::dataFileResult mainMenu::dataExtraction::readDataText(string_view text, const string & title,
+	const string & experimentType, const size_t & threads) {
+	dataFileResult result{ false, "", NULL, NULL, 0, 0, text.size() };
+	size_t counters[3]{ 0,0,0 };
+	size_t linesRead{ 0 }, bytesRead{ 0 };
+	// Chunks with only errors are kept until the type of the experiment is known
+	vector<parsedDataBatch> waitingBatches;
+
+	chunkReader<parsedDataBatch> reader{ text, threads };
+	bool valid{ reader.run([](string_view chunk, parsedDataBatch & batch) { parseDataChunk(chunk, parseDataLine, batch); },
+		[&](parsedDataBatch & batch) {
+		if (batch.invalidLine != 0) {
+			result.message = "Invalid measurement found on line " + to_string(linesRead + batch.invalidLine);
+			return(false);
+		}
+		for (size_t i{ 0 }; i < 3; i++) { counters[i] += batch.counters[i]; }
+		linesRead += batch.lineCount;
+		bytesRead += batch.bytes;
+		// Check counters make sense: Either numeric or string, not both
+		if (counters[numericLine] != 0 && counters[stringLine] != 0) { result.message = "Mix of numeric and string inputs found"; return(false); }
+		waitingBatches.push_back(move(batch));
+		if (result.numericExp == NULL && result.stringExp == NULL) {
+			if (counters[numericLine] == 0 && counters[stringLine] == 0) { return(true); }
+			// Create the experiment, with space for the number of lines expected from the chunks read so far
+			double scale{ double(text.size()) / double(bytesRead) };
+			size_t mc{ size_t(double(counters[numericLine] + counters[stringLine]) * scale) }, ec{ size_t(double(counters[errorLine]) * scale) };
+			if (counters[numericLine] != 0) { result.numericExp = new experiment<double>{ mc, ec, title }; }
+			else { result.stringExp = new experiment<string>{ mc, ec, title }; }
+		}
+		for (size_t i{ 0 }; i < waitingBatches.size(); i++) {
+			if (result.numericExp != NULL) { addParsedLines(waitingBatches[i], result.numericExp); }
+			else { addParsedLines(waitingBatches[i], result.stringExp); }
+		}
+		waitingBatches.clear();
+		return(true);
+	}) };
+	if (valid && counters[numericLine] + counters[stringLine] + counters[errorLine] == 0) { result.message = "No measurements found"; valid = false; }
+	if (!valid) {
+		delete result.numericExp; delete result.stringExp;
+		result.numericExp = NULL; result.stringExp = NULL;
+		return(result);
+	}
+
+	// Data with only errors
+	if (result.numericExp == NULL && result.stringExp == NULL) {
+		if (experimentType == "numeric") { result.numericExp = new experiment<double>{ 0, counters[errorLine], title }; }
+		else { result.stringExp = new experiment<string>{ 0, counters[errorLine], title }; }
+		for (size_t i{ 0 }; i < waitingBatches.size(); i++) {
+			if (result.numericExp != NULL) { addParsedLines(waitingBatches[i], result.numericExp); }
+			else { addParsedLines(waitingBatches[i], result.stringExp); }
+		}
+	}
+	result.measurements = counters[numericLine] + counters[stringLine];
+	result.errors = counters[errorLine];
+	result.valid = true;
+	return(result);
+}
+
+// A function to find the data files in a list of names seperated by commas
+bool mainMenu::dataExtraction::findDataFiles(const string & input, vector<string> & fileNames) {
+	fileNames.clear();
+	vector<string_view> names;
+	splitStringView(input, names);
+	for (size_t i{ 0 }; i < names.size(); i++) {
+		if (names[i].find_first_of("*?") == string_view::npos) {
+			// Plain file name
+			ifstream inputFile{ path + string(names[i]) };
+			if (!inputFile.good()) { cout << "Could not open file '" << names[i] << "'. Try again." << endl; return(false); }
+			fileNames.emplace_back(names[i]);
+			continue;
+		}
+		// Match the pattern against every file in the data folder
+		vector<string> matches;
+		error_code error;
+		for (filesystem::directory_iterator entry{ path.empty() ? string(".") : path, error }, end; !error && entry != end; entry.increment(error)) {
+			string name{ entry->path().filename().string() };
+			if (entry->is_regular_file(error) && matchesPattern(name, names[i])) { matches.push_back(name); }
+		}
+		if (matches.empty()) { cout << "No files match '" << names[i] << "'. Try again." << endl; return(false); }
+		sort(matches.begin(), matches.end());
+		fileNames.insert(fileNames.end(), matches.begin(), matches.end());
+	}
+	// A file listed twice is only read once
+	vector<string> uniqueNames;
+	for (size_t i{ 0 }; i < fileNames.size(); i++) {
+		if (find(uniqueNames.begin(), uniqueNames.end(), fileNames[i]) == uniqueNames.end()) { uniqueNames.push_back(fileNames[i]); }
+	}
+	fileNames = uniqueNames;
+	return(true);
+}
+
+// A function to make an experiment title from a file name, by removing the folder and extension
+string mainMenu::dataExtraction::titleFromFileName(const string & fileName) {
+	return (filesystem::path(fileName).stem().string());
+}
+
+// A function to read the measurements of an experiment from a save file in memory until the end line is found
+template <class V> bool mainMenu::dataExtraction::readSaveExperiment(string_view fileData, size_t & position, experiment<V>* exp,
+	string_view endLine, const size_t & threads) {
+	size_t end{ findLine(fileData, position, endLine) };
+	if (end == string_view::npos) {
+		cout << "Warning: Save file is corrupted, experiment " << exp->getTitle() << " has no end." << endl;
+		return(false);
+	}
+	lineParser parseLine{ is_same<V, double>::value ? parseNumericSaveLine : parseStringSaveLine };
+	chunkReader<parsedDataBatch> reader{ fileData.substr(position, end - position), threads };
+	bool valid{ reader.run([parseLine](string_view chunk, parsedDataBatch & batch) { parseDataChunk(chunk, parseLine, batch); },
+		[exp](parsedDataBatch & batch) {
+		// Lines before an invalid line are still added
+		addParsedLines(batch, exp);
+		if (batch.invalidLine != 0) {
+			cout << "Warning: Save file is corrupted, line not valid: " << batch.invalidText << endl;
+			return(false);
+		}
+		return(true);
+	}) };
+	// Move past the end line
+	string_view fileLine;
+	position = end;
+	getNextLine(fileData, position, fileLine);
+	return(valid);
+}
+
+// A function to open a save file given the name typed by the user
+bool mainMenu::dataExtraction::openSaveFile(const string & name, mappedFile & file, string & fileName) {
+	vector<string> candidates;
+	string extension{ name.size() > 4 ? name.substr(name.size() - 4) : string() };
+	if (extension == ".dat" || extension == ".bin" || extension == ".jnl") { candidates.push_back("SAV_" + name); }
+	else { candidates = { "SAV_" + name + ".dat", "SAV_" + name + ".bin", "SAV_" + name + ".jnl" }; }
+	for (size_t i{ 0 }; i < candidates.size(); i++) {
+		if (file.open(path + candidates[i])) { fileName = candidates[i]; return(true); }
+	}
+	return(false);
+}
+
+// A function to check if a save file in memory is in the binary format, by looking for the binary header
+bool mainMenu::dataExtraction::isBinarySaveFile(string_view fileData) {
+	return (fileData.substr(0, binarySaveHeader.size()) == binarySaveHeader);
+}
+
+// A function to add all the experiments in a text save file in memory to the program
+bool mainMenu::dataExtraction::loadTextSaveFile(string_view fileData) {
+	size_t position{ 0 };
+	string_view fileLine;
+	vector<string_view> substrings;
+	// Now copy data from save file
+	while (getNextLine(fileData, position, fileLine)) {
+		if (fileLine.length() == 0) { continue; }
+		splitStringView(fileLine, substrings);
+
+		// Check for correlation line
+		if (substrings[0] == "correlate" && substrings.size() > 2) {
+			correlate(getExperimentHandle(string(substrings[1])), getExperimentHandle(string(substrings[2])), false);
+		}
+
+		// Check for experiment lines
+		if (fileLine == "NUMERIC_EXPERIMENT_BEGIN" || fileLine == "STRING_EXPERIMENT_BEGIN") {
+			bool isNumeric{ fileLine == "NUMERIC_EXPERIMENT_BEGIN" };
+			// Next line contains the title and the number of measurements and errors
+			size_t mc{ 0 }, ec{ 0 };
+			if (!getNextLine(fileData, position, fileLine)) { fileLine = string_view{}; }
+			splitStringView(fileLine, substrings);
+			if (substrings.size() < 3 || !stringToSize(substrings[1], mc) || !stringToSize(substrings[2], ec)) {
+				cout << "Warning: Save file is corrupted, experiment header not valid: " << fileLine << endl;
+				return(false);
+			}
+			string title{ substrings[0] };
+			if (!chooseLoadTitle(title)) { return(false); }
+
+			// Create new experiment, with space for the number of measurements and errors given in the file, and read straight in to it
+			bool valid;
+			if (isNumeric) {
+				experiment<double>* tempExp{ new experiment<double>{ mc, ec, title } };
+				valid = readSaveExperiment(fileData, position, tempExp, "NUMERIC_EXPERIMENT_END");
+				tempExp->updateAccounting();
+				experiments.add(tempExp);
+			}
+			else {
+				experiment<string>* tempExp{ new experiment<string>{ mc, ec, title } };
+				valid = readSaveExperiment(fileData, position, tempExp, "STRING_EXPERIMENT_END");
+				tempExp->updateAccounting();
+				experiments.add(tempExp);
+			}
+			if (!valid) { return(false); }
+		}
+	}
+	return(true);
+}
+
+// A function to add all the experiments in a binary save file in memory to the program
+// The file has the following layout, with all numbers little endian (See binaryFileClass.h for how columns are stored):
+//     Header: "SAV_BIN\x1A", version (4 bytes), number of experiments (varint)
+//     Directory, for each experiment: type (1 byte, 0 numeric 1 string), parent (varint), title, measurements (varint), errors (varint)
+//     Data, for each experiment in the same order: unit table, value, error, systError and timestamp columns, unit codes,
+//     error timestamps and a bitmap of the order of input
+// Correlated experiments always come after the experiment they are correlated to
+bool mainMenu::dataExtraction::loadBinarySaveFile(string_view fileData) {
+	binaryReader input{ fileData.substr(binarySaveHeader.size()) };
+	uint32_t version;
+	uint64_t experimentCount;
+	if (!input.readNumber(version) || version != binarySaveVersion) {
+		cout << "Warning: Save file was written by a different version of the program" << endl;
+		return(false);
+	}
+	// Every experiment needs at least 5 bytes in the directory
+	if (!input.readVarint(experimentCount) || experimentCount > input.getRemaining() / 5) {
+		cout << "Warning: Save file is corrupted, header not valid" << endl;
+		return(false);
+	}
+
+	// Read the directory
+	vector<unsigned char> types(experimentCount);
+	vector<uint64_t> parents(experimentCount), mcs(experimentCount), ecs(experimentCount);
+	vector<string> titles(experimentCount);
+	for (size_t i{ 0 }; i < experimentCount; i++) {
+		string_view title;
+		if (!input.readNumber(types[i]) || types[i] > 1 || !input.readVarint(parents[i]) || parents[i] > i || !input.readString(title)
+			|| !input.readVarint(mcs[i]) || !input.readVarint(ecs[i]) || mcs[i] > fileData.size() || ecs[i] > fileData.size()) {
+			cout << "Warning: Save file is corrupted, experiment " << i + 1 << " not valid in the directory" << endl;
+			return(false);
+		}
+		titles[i] = string(title);
+	}
+
+	// Read the data of each experiment, adding it to the program or to the experiment it is correlated to
+	// The handle of the experiment holding each one is kept so correlated experiments can be indexed
+	vector<binarySaveEntry> entries;
+	vector<experimentHandle> holders;
+	for (size_t i{ 0 }; i < experimentCount; i++) {
+		if (!chooseLoadTitle(titles[i])) { return(false); }
+		binarySaveEntry entry{ NULL, NULL, size_t(parents[i]) };
+		bool valid;
+		if (types[i] == 0) {
+			entry.numericExp = new experiment<double>{ 0, 0, titles[i] };
+			valid = entry.numericExp->readBinaryData(input, size_t(mcs[i]), size_t(ecs[i]));
+			if (valid) { entry.numericExp->updateAccounting(); }
+			else { delete entry.numericExp; }
+		}
+		else {
+			entry.stringExp = new experiment<string>{ 0, 0, titles[i] };
+			valid = entry.stringExp->readBinaryData(input, size_t(mcs[i]), size_t(ecs[i]));
+			if (valid) { entry.stringExp->updateAccounting(); }
+			else { delete entry.stringExp; }
+		}
+		if (!valid) {
+			cout << "Warning: Save file is corrupted, data of experiment " << titles[i] << " not valid" << endl;
+			return(false);
+		}
+
+		if (entry.parent == 0) {
+			if (entry.numericExp != NULL) { holders.push_back(experiments.add(entry.numericExp)); }
+			else { holders.push_back(experiments.add(entry.stringExp)); }
+		}
+		else {
+			const experimentHandle holder{ holders[entry.parent - 1] };
+			holders.push_back(holder);
+			const binarySaveEntry & parent{ entries[entry.parent - 1] };
+			if (parent.numericExp != NULL) {
+				if (entry.numericExp != NULL) { experiments.addCorrelated(holder, parent.numericExp, entry.numericExp); }
+				else { experiments.addCorrelated(holder, parent.numericExp, entry.stringExp); }
+			}
+			else {
+				if (entry.numericExp != NULL) { experiments.addCorrelated(holder, parent.stringExp, entry.numericExp); }
+				else { experiments.addCorrelated(holder, parent.stringExp, entry.stringExp); }
+			}
+		}
+		entries.push_back(entry);
+	}
+	return(true);
+}
+
+// A function to write the given experiments to a stream in the text format
+bool mainMenu::dataExtraction::writeTextSaveFile(ostream & output, const vector<experiment<double>*> & numericExperiments,
+	const vector<experiment<string>*> & stringExperiments) {
+	// Loop through experiments creating the appropriate code in the save file
+	for (size_t i{ 0 }; i < numericExperiments.size(); i++) {
+		numericExperiments[i]->writeSaveFile(output);
+	}
+	for (size_t i{ 0 }; i < stringExperiments.size(); i++) {
+		stringExperiments[i]->writeSaveFile(output);
+	}
+	output.flush();
+	return (output.good());
+}
+
+// A function to write the given experiments to a stream in the binary format (Layout described in loadBinarySaveFile)
+bool mainMenu::dataExtraction::writeBinarySaveFile(ostream & output, const vector<experiment<double>*> & numericExperiments,
+	const vector<experiment<string>*> & stringExperiments) {
+	// List every experiment, with correlated experiments straight after the experiment they are correlated to
+	vector<binarySaveEntry> entries;
+	for (size_t i{ 0 }; i < numericExperiments.size(); i++) { listBinarySaveEntries(numericExperiments[i], 0, entries); }
+	for (size_t i{ 0 }; i < stringExperiments.size(); i++) { listBinarySaveEntries(stringExperiments[i], 0, entries); }
+
+	binaryWriter writer{ output };
+	writer.writeBytes(binarySaveHeader.data(), binarySaveHeader.size());
+	writer.writeNumber(binarySaveVersion);
+	writer.writeVarint(entries.size());
+	// Directory
+	for (size_t i{ 0 }; i < entries.size(); i++) {
+		bool isNumeric{ entries[i].numericExp != NULL };
+		writer.writeNumber((unsigned char)(isNumeric ? 0 : 1));
+		writer.writeVarint(entries[i].parent);
+		if (isNumeric) {
+			writer.writeString(entries[i].numericExp->getTitle());
+			writer.writeVarint(entries[i].numericExp->getMeasurementCounter());
+			writer.writeVarint(entries[i].numericExp->getErrorCounter());
+		}
+		else {
+			writer.writeString(entries[i].stringExp->getTitle());
+			writer.writeVarint(entries[i].stringExp->getMeasurementCounter());
+			writer.writeVarint(entries[i].stringExp->getErrorCounter());
+		}
+	}
+	// Data
+	for (size_t i{ 0 }; i < entries.size(); i++) {
+		if (entries[i].numericExp != NULL) { entries[i].numericExp->writeBinaryData(writer); }
+		else { entries[i].stringExp->writeBinaryData(writer); }
+	}
+	bool written{ writer.flush() };
+	output.flush();
+	return (written && output.good());
+}
+
+// A function to write the given experiments to a save file in the text or binary format, replacing fileName once it is on disk
+mainMenu::dataExtraction::saveResult mainMenu::dataExtraction::writeSaveFile(const string & fileName, const bool & binary,
+	const vector<experiment<double>*> & numericExperiments, const vector<experiment<string>*> & stringExperiments) {
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	saveResult result{ false, 0, 0 };
+	atomicFile saveFile;
+	if (saveFile.open(fileName)) {
+		ostream & output{ saveFile.getStream() };
+		bool written{ binary ? writeBinarySaveFile(output, numericExperiments, stringExperiments)
+			: writeTextSaveFile(output, numericExperiments, stringExperiments) };
+		if (written) { result.bytes = size_t(output.tellp()); }
+		// If anything failed the temporary file is deleted when saveFile is destroyed, leaving the old file as it was
+		result.written = written && saveFile.commit();
+	}
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	return (result);
+}
+
+// A function to tell the user the result of writing a save file
+void mainMenu::dataExtraction::printSaveResult(const string & fileName, const saveResult & result) {
+	if (!result.written) {
+		cout << "Warning: Could not write '" << fileName << "'. Any previous file with this name has been left as it was." << endl;
+		return;
+	}
+	double megabytes{ double(result.bytes) / (1024. * 1024.) };
+	cout << "Saved " << megabytes << " MB to '" << fileName << "' in " << result.seconds << " s";
+	if (result.seconds > 0) { cout << " (" << megabytes / result.seconds << " MB/s)"; }
+	cout << endl;
+}
+
+// A function to copy an experiment and its correlated experiments, so they can be saved in the background
+template <class V> experiment<V>* mainMenu::dataExtraction::copyForSave(const experiment<V>* exp) {
+	experiment<V>* output{ new experiment<V>{ *exp } };
+	output->releaseAccounting();
+	for (size_t i{ 0 }; i < exp->getNumericCorrelatedVector().size(); i++) {
+		output->getNumericCorrelatedVector().push_back(copyForSave(exp->getNumericCorrelatedVector()[i]));
+	}
+	for (size_t i{ 0 }; i < exp->getStringCorrelatedVector().size(); i++) {
+		output->getStringCorrelatedVector().push_back(copyForSave(exp->getStringCorrelatedVector()[i]));
+	}
+	return (output);
+}
+
+// Functions to list an experiment and its correlated experiments in the order they are written to a binary save file
+void mainMenu::dataExtraction::listBinarySaveEntries(experiment<double>* exp, const size_t & parent, vector<binarySaveEntry> & entries) {
+	entries.push_back(binarySaveEntry{ exp, NULL, parent });
+	listCorrelatedSaveEntries(exp, entries);
+}
+void mainMenu::dataExtraction::listBinarySaveEntries(experiment<string>* exp, const size_t & parent, vector<binarySaveEntry> & entries) {
+	entries.push_back(binarySaveEntry{ NULL, exp, parent });
+	listCorrelatedSaveEntries(exp, entries);
+}
+template <class V> void mainMenu::dataExtraction::listCorrelatedSaveEntries(experiment<V>* exp, vector<binarySaveEntry> & entries) {
+	// The experiment was just added to the list, so its correlated experiments have it as their parent
+	size_t parent{ entries.size() };
+	for (size_t i{ 0 }; i < exp->getNumericCorrelatedVector().size(); i++) {
+		listBinarySaveEntries(exp->getNumericCorrelatedVector()[i], parent, entries);
+	}
+	for (size_t i{ 0 }; i < exp->getStringCorrelatedVector().size(); i++) {
+		listBinarySaveEntries(exp->getStringCorrelatedVector()[i], parent, entries);
+	}
+}
+
+// A function to list every experiment in a registry in the order they are written to a binary save file
+void mainMenu::dataExtraction::listBinarySaveEntries(const experimentRegistry & registry, vector<binarySaveEntry> & entries) {
+	vector<experiment<double>*> numericExperiments{ registry.getNumericExperiments() };
+	vector<experiment<string>*> stringExperiments{ registry.getStringExperiments() };
+	for (size_t i{ 0 }; i < numericExperiments.size(); i++) { listBinarySaveEntries(numericExperiments[i], 0, entries); }
+	for (size_t i{ 0 }; i < stringExperiments.size(); i++) { listBinarySaveEntries(stringExperiments[i], 0, entries); }
+}
+
+// ############# //
+// #  JOURNAL  # //
+// ############# //
+
+// A function to check if a save file in memory is a journal
+bool mainMenu::journal::isJournalFile(string_view fileData) {
+	return (fileData.substr(0, journalHeader.size()) == journalHeader);
+}
+
+// A function to add all the experiments in a journal in memory to the program
+// Layout of a journal:
+//     Header: "SAV_JNL\x1A", version (4 bytes)
+//     Records, each with a type (1 byte), length (8 bytes), checksum of the rest of the record (4 bytes), then:
+//         Snapshot (Always the first record): a whole binary save file. Experiments get ids in the order they are listed in it
+//         Add: type (1 byte, 0 numeric 1 string), title, measurements (varint), errors (varint), data as in a binary save file.
+//              The experiment is added uncorrelated, with the next id
+//         Delete: id (varint). The experiment must be uncorrelated, and its correlated experiments are deleted with it
+//         Rename: id (varint), title
+//         Correlate: id of the independent experiment (varint), id of the uncorrelated experiment correlated to it (varint)
+//         Append: id (varint), then the new measurements as an experiment: measurements (varint), errors (varint), data
+// The snapshot is only written by replacing the whole file, so its checksum is not used
+bool mainMenu::journal::loadJournalFile(string_view fileData, const string & journalName, const bool & track) {
+	binaryReader input{ fileData.substr(journalHeader.size()) };
+	uint32_t version;
+	if (!input.readNumber(version) || version != journalVersion) {
+		cout << "Warning: Journal was written by a different version of the program" << endl;
+		return(false);
+	}
+
+	// Load in to an empty registry, so the records can only change experiments from this journal
+	experimentRegistry existing;
+	experiments.swap(existing);
+
+	// Load the snapshot. Every experiment has a title from the same journal, so loadBinarySaveFile never asks for a new one
+	unsigned char type;
+	uint64_t length;
+	uint32_t checksum;
+	string_view payload;
+	bool valid{ input.readNumber(type) && type == snapshotRecord && input.readNumber(length) && input.readNumber(checksum)
+		&& length <= input.getRemaining() && input.readBytes(size_t(length), payload) && dataExtraction::isBinarySaveFile(payload) };
+	if (valid) { valid = dataExtraction::loadBinarySaveFile(payload); }
+	else { cout << "Warning: Journal is corrupted, snapshot not valid" << endl; }
+	vector<dataExtraction::binarySaveEntry> byId;
+	dataExtraction::listBinarySaveEntries(experiments, byId);
+	size_t snapshotEnd{ journalHeader.size() + input.getPosition() }, validEnd{ snapshotEnd };
+
+	// Replay the records in order. A record which doesn't match its checksum was only partly written when the program stopped,
+	// so it and anything after it is ignored
+	size_t recordCount{ 0 };
+	while (valid && input.getRemaining() != 0) {
+		recordCount++;
+		if (!input.readNumber(type) || !input.readNumber(length) || !input.readNumber(checksum) || length > input.getRemaining()
+			|| !input.readBytes(size_t(length), payload) || computeChecksum(payload) != checksum) {
+			cout << "Warning: Journal ends with a change that was only partly saved, it has been ignored" << endl;
+			break;
+		}
+		if (!replayRecord(recordType(type), payload, byId)) {
+			cout << "Warning: Journal is corrupted, change " << recordCount << " not valid" << endl;
+			valid = false;
+		}
+		validEnd = journalHeader.size() + input.getPosition();
+	}
+
+	// Describe the experiments as they are in the journal, before any are renamed below
+	vector<dataExtraction::binarySaveEntry> entries;
+	vector<size_t> ids;
+	unordered_map<const void*, trackedExperiment> loadedExperiments;
+	if (valid && track) {
+		unordered_map<const void*, size_t> idOf;
+		for (size_t i{ 0 }; i < byId.size(); i++) { idOf[getEntryPointer(byId[i])] = i; }
+		dataExtraction::listBinarySaveEntries(experiments, entries);
+		for (size_t i{ 0 }; i < entries.size(); i++) { ids.push_back(idOf[getEntryPointer(entries[i])]); }
+		trackEntries(entries, ids, loadedExperiments);
+	}
+	// Swap the existing experiments back. The loaded ones are deleted with their registry if anything goes wrong
+	experimentRegistry loaded;
+	loaded.swap(experiments);
+	experiments.swap(existing);
+
+	// Check the titles are new, then add the experiments to the program
+	vector<experimentHandle> handles{ loaded.getHandles() };
+	vector<string> titles;
+	for (size_t i{ 0 }; valid && i < handles.size(); i++) {
+		titles.push_back(loaded.getTitle(handles[i]));
+		valid = dataExtraction::chooseLoadTitle(titles.back());
+	}
+	if (!valid) { return(false); }
+	for (size_t i{ 0 }; i < handles.size(); i++) {
+		if (handles[i].type == numericExperiment) {
+			experiment<double>* exp{ loaded.releaseNumeric(handles[i]) };
+			exp->setTitle(titles[i]);
+			experiments.add(exp);
+		}
+		else {
+			experiment<string>* exp{ loaded.releaseString(handles[i]) };
+			exp->setTitle(titles[i]);
+			experiments.add(exp);
+		}
+	}
+
+	// Track the journal, so the next save to it only adds the changes. Anything after the last valid record is cut off then
+	if (track) {
+		fileName = journalName;
+		validLength = validEnd;
+		snapshotLength = snapshotEnd;
+		nextId = byId.size();
+		tracked = move(loadedExperiments);
+		pendingDeletes.clear();
+	}
+	return(true);
+}
+
+// A function to apply one record to the experiments loaded from a journal
+bool mainMenu::journal::replayRecord(const recordType & type, string_view payload, vector<dataExtraction::binarySaveEntry> & byId) {
+	binaryReader record{ payload };
+	uint64_t id, secondId, mc, ec;
+	string_view title;
+	unsigned char experimentType;
+	// All records but add refer to an existing experiment first
+	if (type != addRecord && (!record.readVarint(id) || id >= byId.size() || getEntryPointer(byId[size_t(id)]) == NULL)) { return(false); }
+	dataExtraction::binarySaveEntry entry{ type != addRecord ? byId[size_t(id)] : dataExtraction::binarySaveEntry{ NULL, NULL, 0 } };
+
+	if (type == addRecord) {
+		if (!record.readNumber(experimentType) || experimentType > 1 || !record.readString(title) || !record.readVarint(mc)
+			|| !record.readVarint(ec) || mc > payload.size() || ec > payload.size()) { return(false); }
+		bool valid;
+		if (experimentType == 0) {
+			entry.numericExp = new experiment<double>{ 0, 0, string(title) };
+			valid = entry.numericExp->readBinaryData(record, size_t(mc), size_t(ec));
+			if (valid) { entry.numericExp->updateAccounting(); experiments.add(entry.numericExp); }
+			else { delete entry.numericExp; }
+		}
+		else {
+			entry.stringExp = new experiment<string>{ 0, 0, string(title) };
+			valid = entry.stringExp->readBinaryData(record, size_t(mc), size_t(ec));
+			if (valid) { entry.stringExp->updateAccounting(); experiments.add(entry.stringExp); }
+			else { delete entry.stringExp; }
+		}
+		if (!valid) { return(false); }
+		byId.push_back(entry);
+		return(true);
+	}
+
+	if (type == renameRecord) {
+		if (!record.readString(title)) { return(false); }
+		if (entry.numericExp != NULL) { experiments.rename(entry.numericExp, string(title)); }
+		else { experiments.rename(entry.stringExp, string(title)); }
+		return(true);
+	}
+
+	if (type == appendRecord) {
+		if (!record.readVarint(mc) || !record.readVarint(ec) || mc > payload.size() || ec > payload.size()) { return(false); }
+		if (entry.numericExp != NULL) {
+			experiment<double> newMeasurements{ 0, 0, "" };
+			if (!newMeasurements.readBinaryData(record, size_t(mc), size_t(ec))) { return(false); }
+			entry.numericExp->appendFrom(newMeasurements, 0, 0);
+			entry.numericExp->updateAccounting();
+		}
+		else {
+			experiment<string> newMeasurements{ 0, 0, "" };
+			if (!newMeasurements.readBinaryData(record, size_t(mc), size_t(ec))) { return(false); }
+			entry.stringExp->appendFrom(newMeasurements, 0, 0);
+			entry.stringExp->updateAccounting();
+		}
+		return(true);
+	}
+
+	if (type != deleteRecord && type != correlateRecord) { return(false); }
+	// Both of these take an experiment which isn't correlated out of the registry
+	if (type == correlateRecord && (!record.readVarint(secondId) || secondId >= byId.size() || secondId == id
+		|| getEntryPointer(byId[size_t(secondId)]) == NULL)) { return(false); }
+	dataExtraction::binarySaveEntry & moved{ type == deleteRecord ? entry : byId[size_t(secondId)] };
+	experimentHandle movedHandle, holder;
+	if (!experiments.find(moved.numericExp != NULL ? moved.numericExp->getTitle() : moved.stringExp->getTitle(), movedHandle)
+		|| getEntryPointer(moved) != (moved.numericExp != NULL ? (const void*)experiments.getNumeric(movedHandle)
+			: (const void*)experiments.getString(movedHandle))) { return(false); }
+	// An experiment can't be correlated to one of its own correlated experiments
+	if (type == correlateRecord && (!experiments.findHolder(entry.numericExp != NULL ? entry.numericExp->getTitle()
+		: entry.stringExp->getTitle(), holder) || holder == movedHandle)) { return(false); }
+	if (moved.numericExp != NULL) { experiments.releaseNumeric(movedHandle); }
+	else { experiments.releaseString(movedHandle); }
+
+	if (type == deleteRecord) {
+		// The ids of the experiment and its correlated experiments are no longer used
+		vector<dataExtraction::binarySaveEntry> deleted;
+		if (entry.numericExp != NULL) { dataExtraction::listBinarySaveEntries(entry.numericExp, 0, deleted); }
+		else { dataExtraction::listBinarySaveEntries(entry.stringExp, 0, deleted); }
+		unordered_map<const void*, bool> isDeleted;
+		for (size_t i{ 0 }; i < deleted.size(); i++) { isDeleted[getEntryPointer(deleted[i])] = true; }
+		for (size_t i{ 0 }; i < byId.size(); i++) {
+			if (isDeleted.count(getEntryPointer(byId[i])) != 0) { byId[i] = dataExtraction::binarySaveEntry{ NULL, NULL, 0 }; }
+		}
+		if (entry.numericExp != NULL) { delete entry.numericExp; }
+		else { delete entry.stringExp; }
+		return(true);
+	}
+
+	// Correlate the moved experiment to the first one
+	if (entry.numericExp != NULL) {
+		if (moved.numericExp != NULL) { experiments.addCorrelated(holder, entry.numericExp, moved.numericExp); }
+		else { experiments.addCorrelated(holder, entry.numericExp, moved.stringExp); }
+	}
+	else {
+		if (moved.numericExp != NULL) { experiments.addCorrelated(holder, entry.stringExp, moved.numericExp); }
+		else { experiments.addCorrelated(holder, entry.stringExp, moved.stringExp); }
+	}
+	return(true);
+}
+
+// A function to save every experiment to a journal, appending the changes if it is the journal being tracked
+mainMenu::dataExtraction::saveResult mainMenu::journal::saveJournal(const string & journalName) {
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	dataExtraction::saveResult result{ false, 0, 0 };
+	string records;
+	bool compact{ journalName != fileName || !findChanges(records) };
+	// Replaying lots of records is slower than loading a snapshot, so once they are bigger than the snapshot a new one is written
+	if (!compact && (validLength - snapshotLength) + records.size() > snapshotLength) {
+		cout << "Compacting the journal in to a new snapshot" << endl;
+		compact = true;
+	}
+
+	if (compact) {
+		result.written = writeSnapshot(journalName);
+		if (result.written) { result.bytes = validLength; }
+	}
+	else if (records.empty()) { result.written = true; }
+	else {
+		// Cut off anything after the last valid record (Left by a save that stopped part way), then add the new records
+		error_code error;
+		filesystem::resize_file(journalName, validLength, error);
+		fstream journalFile{ journalName, ios::in | ios::out | ios::binary };
+		if (!error && journalFile.good()) {
+			journalFile.seekp(streamoff(validLength));
+			journalFile.write(records.data(), streamsize(records.size()));
+			journalFile.flush();
+			result.written = journalFile.good();
+		}
+		journalFile.close();
+		result.written = result.written && atomicFile::syncFile(journalName);
+		if (result.written) {
+			validLength += records.size();
+			result.bytes = records.size();
+			pendingDeletes.clear();
+		}
+		// The tracked experiments already include these changes, so the next save must write a new journal instead
+		else { fileName.clear(); }
+	}
+	result.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+	return (result);
+}
+
+// A function to write a new journal holding only a snapshot of every experiment, and start tracking it
+bool mainMenu::journal::writeSnapshot(const string & journalName) {
+	fileName.clear();
+	atomicFile journalFile;
+	if (!journalFile.open(journalName)) { return(false); }
+	ostream & output{ journalFile.getStream() };
+	{
+		binaryWriter writer{ output };
+		writer.writeBytes(journalHeader.data(), journalHeader.size());
+		writer.writeNumber(journalVersion);
+		writer.writeNumber((unsigned char)snapshotRecord);
+		writer.writeNumber(uint64_t(0));
+		writer.writeNumber(uint32_t(0));
+	}
+	// The length of the snapshot is filled in once it is known
+	const streamoff lengthPosition{ streamoff(journalHeader.size() + sizeof(journalVersion) + 1) };
+	const streamoff snapshotStart{ streamoff(journalHeader.size() + sizeof(journalVersion) + recordHeaderSize) };
+	if (!dataExtraction::writeBinarySaveFile(output, experiments.getNumericExperiments(), experiments.getStringExperiments())) { return(false); }
+	streamoff snapshotEnd{ output.tellp() };
+	output.seekp(lengthPosition);
+	{
+		binaryWriter writer{ output };
+		writer.writeNumber(uint64_t(snapshotEnd - snapshotStart));
+	}
+	output.seekp(snapshotEnd);
+	if (!output.good() || !journalFile.commit()) { return(false); }
+
+	// Track the new journal. Experiments are numbered in the order they are listed in the snapshot
+	vector<dataExtraction::binarySaveEntry> entries;
+	dataExtraction::listBinarySaveEntries(experiments, entries);
+	vector<size_t> ids(entries.size());
+	for (size_t i{ 0 }; i < ids.size(); i++) { ids[i] = i; }
+	tracked.clear();
+	trackEntries(entries, ids, tracked);
+	fileName = journalName;
+	validLength = snapshotLength = size_t(snapshotEnd);
+	nextId = entries.size();
+	pendingDeletes.clear();
+	return(true);
+}
+
+// A function to add records for the changes since the journal was last written, updating the tracked experiments
+bool mainMenu::journal::findChanges(string & records) {
+	for (size_t i{ 0 }; i < pendingDeletes.size(); i++) {
+		ostringstream payload;
+		{
+			binaryWriter writer{ payload };
+			writer.writeVarint(pendingDeletes[i]);
+		}
+		addRecordTo(records, deleteRecord, payload.str());
+	}
+	// Experiments are checked in the same order as a snapshot, so new experiments are added before anything is correlated to them
+	vector<dataExtraction::binarySaveEntry> entries;
+	dataExtraction::listBinarySaveEntries(experiments, entries);
+	for (size_t i{ 0 }; i < entries.size(); i++) {
+		const void* parent{ entries[i].parent == 0 ? NULL : getEntryPointer(entries[entries[i].parent - 1]) };
+		bool valid{ entries[i].numericExp != NULL ? findExperimentChanges(entries[i].numericExp, parent, records)
+			: findExperimentChanges(entries[i].stringExp, parent, records) };
+		if (!valid) { return(false); }
+	}
+	return(true);
+}
+
+// A function to add records for the changes to one experiment since the journal was last written
+template <class V> bool mainMenu::journal::findExperimentChanges(experiment<V>* exp, const void* parent, string & records) {
+	unordered_map<const void*, trackedExperiment>::iterator found{ tracked.find(exp) };
+	if (found == tracked.end()) {
+		// New experiment, added uncorrelated with all its measurements
+		ostringstream payload;
+		{
+			binaryWriter writer{ payload };
+			writer.writeNumber((unsigned char)(is_same<V, string>::value ? 1 : 0));
+			writer.writeString(exp->getTitle());
+			writer.writeVarint(exp->getMeasurementCounter());
+			writer.writeVarint(exp->getErrorCounter());
+			exp->writeBinaryData(writer);
+		}
+		addRecordTo(records, addRecord, payload.str());
+		trackedExperiment newExperiment{ nextId, exp->getTitle(), NULL, exp->getMeasurementCounter(), exp->getErrorCounter() };
+		found = tracked.emplace(exp, newExperiment).first;
+		nextId++;
+	}
+	trackedExperiment & journalExperiment{ found->second };
+	// Measurements are only ever added and correlations never undone, so anything else needs a new snapshot
+	if (exp->getMeasurementCounter() < journalExperiment.measurements || exp->getErrorCounter() < journalExperiment.errors
+		|| (journalExperiment.parent != NULL && journalExperiment.parent != parent)) { return(false); }
+
+	if (exp->getTitle() != journalExperiment.title) {
+		ostringstream payload;
+		{
+			binaryWriter writer{ payload };
+			writer.writeVarint(journalExperiment.id);
+			writer.writeString(exp->getTitle());
+		}
+		addRecordTo(records, renameRecord, payload.str());
+		journalExperiment.title = exp->getTitle();
+	}
+
+	if (exp->getMeasurementCounter() > journalExperiment.measurements || exp->getErrorCounter() > journalExperiment.errors) {
+		// Only the measurements added since the last save are written
+		experiment<V> newMeasurements{ 0, 0, "" };
+		newMeasurements.appendFrom(*exp, journalExperiment.measurements, journalExperiment.errors);
+		ostringstream payload;
+		{
+			binaryWriter writer{ payload };
+			writer.writeVarint(journalExperiment.id);
+			writer.writeVarint(newMeasurements.getMeasurementCounter());
+			writer.writeVarint(newMeasurements.getErrorCounter());
+			newMeasurements.writeBinaryData(writer);
+		}
+		addRecordTo(records, appendRecord, payload.str());
+		journalExperiment.measurements = exp->getMeasurementCounter();
+		journalExperiment.errors = exp->getErrorCounter();
+	}
+
+	if (journalExperiment.parent != parent) {
+		// The experiment it is correlated to comes first in the list, so it is already tracked
+		ostringstream payload;
+		{
+			binaryWriter writer{ payload };
+			writer.writeVarint(tracked.at(parent).id);
+			writer.writeVarint(journalExperiment.id);
+		}
+		addRecordTo(records, correlateRecord, payload.str());
+		journalExperiment.parent = parent;
+	}
+	return(true);
+}
+
+// A function to add a record to the end of a block of records
+void mainMenu::journal::addRecordTo(string & records, const recordType & type, const string & payload) {
+	ostringstream header;
+	{
+		binaryWriter writer{ header };
+		writer.writeNumber((unsigned char)type);
+		writer.writeNumber(uint64_t(payload.size()));
+		writer.writeNumber(computeChecksum(payload));
+	}
+	records += header.str();
+	records += payload;
+}
+
+// A function to find the address of the experiment in a save entry
+const void* mainMenu::journal::getEntryPointer(const dataExtraction::binarySaveEntry & entry) {
+	if (entry.numericExp != NULL) { return (entry.numericExp); }
+	return (entry.stringExp);
+}
+
+// A function to describe each experiment in a list of save entries, given the id of each
+void mainMenu::journal::trackEntries(const vector<dataExtraction::binarySaveEntry> & entries, const vector<size_t> & ids,
+	unordered_map<const void*, trackedExperiment> & output) {
+	for (size_t i{ 0 }; i < entries.size(); i++) {
+		const void* parent{ entries[i].parent == 0 ? NULL : getEntryPointer(entries[entries[i].parent - 1]) };
+		if (entries[i].numericExp != NULL) {
+			output[entries[i].numericExp] = trackedExperiment{ ids[i], entries[i].numericExp->getTitle(), parent,
+				entries[i].numericExp->getMeasurementCounter(), entries[i].numericExp->getErrorCounter() };
+		}
+		else {
+			output[entries[i].stringExp] = trackedExperiment{ ids[i], entries[i].stringExp->getTitle(), parent,
+				entries[i].stringExp->getMeasurementCounter(), entries[i].stringExp->getErrorCounter() };
+		}
+	}
+}
+
+// A function to stop tracking an experiment and its correlated experiments as they are deleted
+template <class V> void mainMenu::journal::forgetExperiment(const experiment<V>* exp) {
+	unordered_map<const void*, trackedExperiment>::iterator found{ tracked.find(exp) };
+	if (found != tracked.end()) {
+		// Experiments correlated in the journal are deleted along with the experiment they are correlated to
+		if (found->second.parent == NULL) { pendingDeletes.push_back(found->second.id); }
+		tracked.erase(found);
+	}
+	for (size_t i{ 0 }; i < exp->getNumericCorrelatedVector().size(); i++) { forgetExperiment(exp->getNumericCorrelatedVector()[i]); }
+	for (size_t i{ 0 }; i < exp->getStringCorrelatedVector().size(); i++) { forgetExperiment(exp->getStringCorrelatedVector()[i]); }
+}
+
+// ############# //
+// #   FEEDS   # //
+// ############# //
+
+// A function to read the settings of a feed from the command line arguments after "feed"
+bool mainMenu::feed::readArguments(const vector<string> & arguments, feedSettings & settings) {
+	settings = feedSettings{ "", "", 5, 0, "" };
+	bool valid{ arguments.size() >= 2 };
+	for (size_t i{ 2 }; valid && i < arguments.size(); i += 2) {
+		// Every option is followed by a value
+		if (i + 1 >= arguments.size()) { valid = false; }
+		else if (arguments[i] == "--every") { valid = stringToDouble(arguments[i + 1], settings.reportSeconds) && settings.reportSeconds > 0; }
+		else if (arguments[i] == "--idle") { valid = stringToDouble(arguments[i + 1], settings.idleSeconds) && settings.idleSeconds >= 0; }
+		else if (arguments[i] == "--save") { settings.saveName = "SAV_" + arguments[i + 1] + ".jnl"; }
+		else { valid = false; }
+	}
+	if (!valid) {
+		cout << "Usage: feed <data file, or - for the standard input> <experiment title> [--every <seconds between statistics>]"
+			<< " [--idle <seconds without new lines before stopping>] [--save <journal name>]" << endl;
+		return (false);
+	}
+	settings.source = arguments[0];
+	settings.title = arguments[1];
+	return (true);
+}
+
+// A function to follow a feed until it ends, adding every line to a new experiment and showing live statistics
+int mainMenu::feed::followFeed(const feedSettings & settings) {
+	const bool fromPipe{ settings.source == "-" };
+	ifstream file;
+	if (!fromPipe) {
+		file.open(path + settings.source, ios::binary);
+		if (!file.good()) { cout << "Warning: Could not open '" << settings.source << "'." << endl; return (1); }
+	}
+	istream & input{ fromPipe ? cin : file };
+	cout << "Following " << (fromPipe ? string("the standard input") : "'" + settings.source + "'") << " as experiment '"
+		<< settings.title << "'" << endl;
+
+	feedState state{ settings.title, false, noExperiment, vector<timestamp>{}, 0, 0 };
+	string block, line, partialLine;
+	chrono::steady_clock::time_point startTime{ chrono::steady_clock::now() };
+	chrono::steady_clock::time_point lastLine{ startTime }, lastReport{ startTime };
+	bool running{ true };
+	while (running) {
+		// Collect whole lines until the block is full or no more are waiting to be read
+		// A line that reaches the end of the input without a new line may still be being written
+		if (getline(input, line) && !input.eof()) {
+			block += partialLine; block += line; block += '\n';
+			partialLine.clear();
+			lastLine = chrono::steady_clock::now();
+		}
+		else {
+			// Nothing more to read yet, so keep any part of a line until the rest arrives
+			partialLine += line;
+			if (fromPipe || (settings.idleSeconds > 0
+				&& chrono::duration<double>(chrono::steady_clock::now() - lastLine).count() >= settings.idleSeconds)) { running = false; }
+			else {
+				// Wait for the file to grow
+				input.clear();
+				this_thread::sleep_for(chrono::milliseconds(100));
+			}
+		}
+		if (!block.empty() && (!running || block.size() >= feedBlockSize || input.rdbuf()->in_avail() <= 0)) {
+			addFeedLines(block, state);
+			block.clear();
+		}
+
+		chrono::steady_clock::time_point now{ chrono::steady_clock::now() };
+		if (running && chrono::duration<double>(now - lastReport).count() >= settings.reportSeconds) {
+			printLiveStatistics(state, chrono::duration<double>(now - startTime).count());
+			if (state.created && !settings.saveName.empty()) {
+				dataExtraction::saveResult result{ journal::saveJournal(path + settings.saveName) };
+				if (!result.written) { dataExtraction::printSaveResult(settings.saveName, result); }
+			}
+			lastReport = now;
+		}
+	}
+	// The last line of a file doesn't need to end with a new line
+	if (!partialLine.empty()) { addFeedLines(partialLine + '\n', state); }
+
+	cout << "The feed has ended";
+	if (!fromPipe) { cout << " (No new lines for " << settings.idleSeconds << " s)"; }
+	cout << endl;
+	printLiveStatistics(state, chrono::duration<double>(chrono::steady_clock::now() - startTime).count());
+	if (!state.created) { cout << "No measurements were found, so no experiment was made" << endl; return (state.skippedLines != 0 ? 1 : 0); }
+	if (!settings.saveName.empty()) {
+		dataExtraction::saveResult result{ journal::saveJournal(path + settings.saveName) };
+		dataExtraction::printSaveResult(settings.saveName, result);
+		if (!result.written) { return (1); }
+	}
+	if (state.handle.type == numericExperiment) { cout << experiments.getNumeric(state.handle)->makeReport(1).str(); }
+	else { cout << experiments.getString(state.handle)->makeReport(1).str(); }
+	return (0);
+}
+
+// A function to add a block of complete lines to the experiment of a feed
+void mainMenu::feed::addFeedLines(string_view block, feedState & state) {
+	using namespace dataExtraction;
+	parsedDataBatch batch;
+	vector<string_view> substrings;
+	parsedDataLine parsedLine;
+	size_t position{ 0 };
+	string_view line;
+	while (getNextLine(block, position, line)) {
+		state.lineNumber++;
+		if (line.length() == 0) { continue; }
+		if (!parseDataLine(line, substrings, batch.texts, parsedLine)) {
+			cout << "Warning: Line " << state.lineNumber << " of the feed is not a valid measurement, so it was skipped" << endl;
+			state.skippedLines++;
+			continue;
+		}
+		// The first measurement decides the type of the experiment
+		if (!state.created && parsedLine.type != errorLine) {
+			if (parsedLine.type == numericLine) { state.handle = experiments.add(new experiment<double>{ 0, 0, state.title }); }
+			else { state.handle = experiments.add(new experiment<string>{ 0, 0, state.title }); }
+			state.created = true;
+		}
+		if (parsedLine.type != errorLine && (parsedLine.type == numericLine) != (state.handle.type == numericExperiment)) {
+			cout << "Warning: Line " << state.lineNumber << " of the feed is a " << (parsedLine.type == numericLine ? "numeric" : "string")
+				<< " measurement in a " << (state.handle.type == numericExperiment ? "numeric" : "string") << " experiment, so it was skipped"
+				<< endl;
+			state.skippedLines++;
+			continue;
+		}
+		batch.lines.push_back(parsedLine);
+	}
+	if (!state.created) {
+		// Only errors so far
+		for (size_t i{ 0 }; i < batch.lines.size(); i++) { state.waitingErrors.push_back(timestamp::fromPackedDate(batch.lines[i].packedDate)); }
+		return;
+	}
+	if (state.handle.type == numericExperiment) {
+		experiment<double>* exp{ experiments.getNumeric(state.handle) };
+		for (size_t i{ 0 }; i < state.waitingErrors.size(); i++) { exp->addMeasurementError(state.waitingErrors[i]); }
+		addParsedLines(batch, exp);
+		exp->updateAccounting();
+	}
+	else {
+		experiment<string>* exp{ experiments.getString(state.handle) };
+		for (size_t i{ 0 }; i < state.waitingErrors.size(); i++) { exp->addMeasurementError(state.waitingErrors[i]); }
+		addParsedLines(batch, exp);
+		exp->updateAccounting();
+	}
+	state.waitingErrors.clear();
+}
+
+// A function to show the statistics of the experiment of a feed
+void mainMenu::feed::printLiveStatistics(const feedState & state, const double & seconds) {
+	cout << "[" << seconds << " s] ";
+	if (!state.created) { cout << "No measurements yet (" << state.waitingErrors.size() << " errors)" << endl; return; }
+	if (state.handle.type == numericExperiment) {
+		const experiment<double>* exp{ experiments.getNumeric(state.handle) };
+		cout << exp->getMeasurementCounter() << " measurements and " << exp->getErrorCounter() << " errors";
+		if (exp->getMeasurementCounter() != 0) {
+			dataSummary stats{ exp->summary() };
+			cout << ". Average " << stats.mean;
+			if (stats.count > 1) { cout << "+/-" << stats.getErrorOnMean(); }
+			cout << " " << exp->getUnit() << ", from " << stats.min << " to " << stats.max;
+			if (stats.count > 1) { cout << ", standard deviation " << stats.getStandardDeviation(); }
+		}
+	}
+	else {
+		const experiment<string>* exp{ experiments.getString(state.handle) };
+		cout << exp->getMeasurementCounter() << " measurements and " << exp->getErrorCounter() << " errors, with "
+			<< exp->getColumns().getValues().getTable().size() << " different values";
+	}
+	if (state.skippedLines != 0) { cout << " (" << state.skippedLines << " lines skipped)"; }
+	cout << endl;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,92 @@
+// This file contains the definitions for the mappedFileClass.h file
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#endif
+
+#include"mappedFileClass.h"
+
+// Default constructor
+mappedFile::mappedFile() : data{ NULL }, size{ 0 }, opened{ false }, mapped{ false } {
+#ifdef _WIN32
+	fileHandle = INVALID_HANDLE_VALUE; mappingHandle = NULL;
+#else
+	fileDescriptor = -1;
+#endif
+}
+
+// Destructor
+mappedFile::~mappedFile() {
+	close();
+}
+
+// Function to open a file, returning false if it doesn't exist or can't be read
+bool mappedFile::open(const string & fileName) {
+	close();
+#ifdef _WIN32
+	fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE) { return (false); }
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0) {
+		mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mappingHandle != NULL) {
+			data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+			if (data != NULL) { size = size_t(fileSize.QuadPart); mapped = true; }
+		}
+	}
+#else
+	fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) { return (false); }
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) == 0 && S_ISREG(fileStatus.st_mode) && fileStatus.st_size > 0) {
+		void* mapping{ mmap(NULL, size_t(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0) };
+		if (mapping != MAP_FAILED) {
+			// The file will be read from start to end, so let the operating system read ahead
+			madvise(mapping, size_t(fileStatus.st_size), MADV_SEQUENTIAL);
+			data = static_cast<const char*>(mapping); size = size_t(fileStatus.st_size); mapped = true;
+		}
+	}
+#endif
+	opened = true;
+	// Empty files can't be mapped, and some file systems don't allow mapping, so read the file normally instead
+	if (!mapped && !readInToBuffer(fileName)) { close(); return (false); }
+	return (true);
+}
+
+// Function to read a file in to the buffer, used when mapping fails
+bool mappedFile::readInToBuffer(const string & fileName) {
+	ifstream inputFile{ fileName, ios::binary | ios::ate };
+	if (!inputFile.good()) { return (false); }
+	streamoff fileSize{ inputFile.tellg() };
+	if (fileSize < 0) { return (false); }
+	buffer.resize(size_t(fileSize));
+	inputFile.seekg(0);
+	if (fileSize != 0 && !inputFile.read(buffer.data(), fileSize)) { return (false); }
+	data = buffer.data(); size = buffer.size();
+	return (true);
+}
+
+// Function to unmap and close the file
+void mappedFile::close() {
+#ifdef _WIN32
+	if (mapped) { UnmapViewOfFile(data); }
+	if (mappingHandle != NULL) { CloseHandle(mappingHandle); mappingHandle = NULL; }
+	if (fileHandle != INVALID_HANDLE_VALUE) { CloseHandle(fileHandle); fileHandle = INVALID_HANDLE_VALUE; }
+#else
+	if (mapped) { munmap(const_cast<char*>(data), size); }
+	if (fileDescriptor >= 0) { ::close(fileDescriptor); fileDescriptor = -1; }
+#endif
+	buffer.clear(); buffer.shrink_to_fit();
+	data = NULL; size = 0; opened = false; mapped = false;
+}
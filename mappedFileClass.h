@@ -0,0 +1,58 @@
+// This header contains the mappedFile class. This gives read only access to the whole of a file as one block of memory,
+// so large save files can be parsed in place without copying them line by line in to strings
+// Functions defined in the mappedFileClass.cpp file
+
+#ifndef MAPPED_FILE_CLASS_H
+#define MAPPED_FILE_CLASS_H
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<cstddef>
+
+// Class mapping a file in to memory. If the operating system can't map the file it is read in to a buffer instead
+class mappedFile {
+private:
+	// Start and size of the file contents in memory
+	const char* data;
+	size_t size;
+	// Buffer holding the file if it couldn't be mapped
+	vector<char> buffer;
+	// Operating system handles for the mapping
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#else
+	int fileDescriptor;
+#endif
+	// Booleans recording if a file is open, and if it is mapped rather than in the buffer
+	bool opened, mapped;
+
+	// Function to read a file in to the buffer, used when mapping fails
+	bool readInToBuffer(const string & fileName);
+
+public:
+	// Default constructor
+	mappedFile();
+
+	// Destructor
+	~mappedFile();
+
+	// A mapped file owns operating system handles, so it can't be copied
+	mappedFile(const mappedFile &file) = delete;
+	mappedFile & operator=(const mappedFile &file) = delete;
+
+	// Function to open a file, returning false if it doesn't exist or can't be read
+	bool open(const string & fileName);
+
+	// Function to unmap and close the file
+	void close();
+
+	// Accesor functions
+	bool isOpen() const { return (opened); }
+	bool isMapped() const { return (mapped); }
+	const char* getData() const { return (data); }
+	size_t getSize() const { return (size); }
+};
+
+#endif
@@ -43,7 +43,7 @@ public:
 
 	// Call >> operator friend of class
 	template <class T> friend istream & operator >> (istream &is, measurement<T> & mes);
-	template <class T> friend ostream & operator << (ostream &os, measurement<T> & mes);
+	template <class T> friend ostream & operator << (ostream &os, const measurement<T> & mes);
 
 	// Accesor functions
 	V getValue() const { return(value); }
@@ -112,9 +112,10 @@ template<class V> istream & operator >> (istream & is, measurement<V>& mes){
 	try {
 		string fullLine;
 		getline(is, fullLine);
-		vector<string> substrings{ splitString(fullLine) };
-		mes.value = substrings[0]; mes.error = substrings[1]; 
-		mes.systError = substrings[2]; mes.unit = substrings[3]; mes.time = timestamp(substrings[4]);
+		vector<string_view> substrings;
+		splitStringView(fullLine, substrings);
+		mes.value = string(substrings[0]); mes.error = string(substrings[1]);
+		mes.systError = string(substrings[2]); mes.unit = substrings[3]; mes.time = timestamp(string(substrings[4]));
 		return (is);
 	}
 	catch (...) {
@@ -128,9 +129,10 @@ template<> istream & operator >> (istream & is, measurement<string>& mes) {
 	try {
 		string fullLine;
 		getline(is, fullLine);
-		vector<string> substrings{ splitString(fullLine) };
-		mes.value = substrings[0]; mes.error = "N/A"; 
-		mes.systError = "N/A"; mes.unit = "N/A"; mes.time = timestamp(substrings.back());
+		vector<string_view> substrings;
+		splitStringView(fullLine, substrings);
+		mes.value = string(substrings[0]); mes.error = "N/A";
+		mes.systError = "N/A"; mes.unit = "N/A"; mes.time = timestamp(string(substrings.back()));
 		return (is);
 	}
 	catch (...) {
@@ -140,7 +142,7 @@ template<> istream & operator >> (istream & is, measurement<string>& mes) {
 }
 
 // Define << operator
-template<class V> ostream & operator << (ostream & os, measurement<V>& mes) {
+template<class V> ostream & operator << (ostream & os, const measurement<V>& mes) {
 	os << mes.value << ", " << mes.error << ", " << mes.systError << ", " << mes.unit << ", " << mes.time;
 	return os;
 }
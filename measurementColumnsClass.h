@@ -0,0 +1,202 @@
+// This header contains the measurementColumns class. This is the storage used inside experiments, where each part of a
+// measurement is kept in its own contiguous column rather than storing an array of measurement objects.
+// Since this is a template class everything is defined in the header
+
+#ifndef MEASUREMENT_COLUMNS_CLASS_H
+#define MEASUREMENT_COLUMNS_CLASS_H
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<string_view>
+#include"timestampClass.h"
+#include"measurementClass.h"
+#include"binaryFileClass.h"
+#include"stringColumnClass.h"
+
+// Type of column storing the values, errors and statistical errors of measurements. Numbers are stored in a plain vector, and
+// strings in a dictionary encoded stringColumn
+template <class V> struct columnType { typedef vector<V> type; };
+template <> struct columnType<string> { typedef stringColumn type; };
+
+// Class template storing many measurements as columns. The nth entry of every column belongs to measurement n
+// Functions looping over all values (averages, fits, etc.) can then read a contiguous array of numbers directly
+template <class V> class measurementColumns {
+public:
+	// Type of the value, error and statistical error columns
+	typedef typename columnType<V>::type column;
+
+private:
+	// Columns for the value, error, statistical error and timestamp of each measurement
+	column values, errors, systErrors;
+	vector<timestamp> times;
+	// Table of all the different units in the columns. Almost always there is only one
+	vector<string> units;
+	// Index in the unit table for each measurement. This is left empty while every measurement has the same unit
+	vector<unsigned short> unitCodes;
+
+	// Function returning the index of a unit in the unit table, adding it to the table if it is new
+	unsigned short getUnitCode(string_view unit);
+	// Function to store the unit code of a measurement, creating the unitCodes column once a second unit is found
+	void setUnitCode(const size_t & index, const unsigned short & code);
+
+	// Functions to overwrite an entry of a column, and to find the bytes allocated by a column, for either type of column
+	static void setEntry(vector<V> & entries, const size_t & index, const V & entry) { entries[index] = entry; }
+	static void setEntry(stringColumn & entries, const size_t & index, string_view entry) { entries.set(index, entry); }
+	static size_t getColumnMemory(const vector<V> & entries) { return (entries.capacity() * sizeof(V)); }
+	static size_t getColumnMemory(const stringColumn & entries) { return (entries.getMemoryUsage()); }
+
+public:
+	// Number of measurements stored
+	size_t size() const { return (values.size()); }
+	// Number of measurements there is space for
+	size_t capacity() const { return (times.capacity()); }
+
+	// Function to make space for a number of measurements without adding them
+	void reserve(const size_t & capacity);
+
+	// Function to add a measurement to the end of the columns
+	void push_back(const measurement<V> & mes);
+	// Function to add a measurement from its parts, used when loading files so no measurement object is built
+	void push_back(const V & value, const V & error, const V & systError, string_view unit, const timestamp & time);
+
+	// Function to overwrite an existing measurement
+	void set(const size_t & index, const measurement<V> & mes);
+
+	// Function to rebuild a full measurement from the columns
+	measurement<V> get(const size_t & index) const;
+
+	// Accesor functions for the columns
+	const column & getValues() const { return (values); }
+	const column & getErrors() const { return (errors); }
+	const column & getSystErrors() const { return (systErrors); }
+	const vector<timestamp> & getTimes() const { return (times); }
+	const string & getUnit(const size_t & index) const;
+
+	// Number of bytes allocated by the columns
+	size_t getMemoryUsage() const;
+
+	// Function to write the unit table and every column to a binary save file
+	void writeBinary(binaryWriter & output) const;
+
+	// Function to replace the columns with count measurements read from a binary save file. Returns false if the data isn't valid
+	bool readBinary(binaryReader & input, const size_t & count);
+};
+
+// ############################## //
+// #    Function definitions    # //
+// ############################## //
+
+// Function returning the index of a unit in the unit table, adding it to the table if it is new
+template <class V> unsigned short measurementColumns<V>::getUnitCode(string_view unit) {
+	for (size_t i{ 0 }; i < units.size(); i++) {
+		if (units[i] == unit) { return ((unsigned short)i); }
+	}
+	if (units.size() > 0xFFFF) {
+		cout << "Warning: Too many different units in one experiment. Exiting program" << endl;
+		exit(1);
+	}
+	units.push_back(string(unit));
+	return ((unsigned short)(units.size() - 1));
+}
+
+// Function to store the unit code of a measurement, creating the unitCodes column once a second unit is found
+template <class V> void measurementColumns<V>::setUnitCode(const size_t & index, const unsigned short & code) {
+	if (unitCodes.empty()) {
+		if (code == 0) { return; }
+		unitCodes.assign(values.size(), 0);
+	}
+	unitCodes[index] = code;
+}
+
+// Function to make space for a number of measurements without adding them
+template <class V> void measurementColumns<V>::reserve(const size_t & capacity) {
+	values.reserve(capacity); errors.reserve(capacity); systErrors.reserve(capacity); times.reserve(capacity);
+	if (!unitCodes.empty()) { unitCodes.reserve(capacity); }
+}
+
+// Function to add a measurement to the end of the columns
+template <class V> void measurementColumns<V>::push_back(const measurement<V> & mes) {
+	values.push_back(mes.getValue()); errors.push_back(mes.getError()); systErrors.push_back(mes.getSystError());
+	times.push_back(mes.getTime());
+	if (!unitCodes.empty()) { unitCodes.push_back(0); }
+	setUnitCode(values.size() - 1, getUnitCode(mes.getUnit()));
+}
+
+// Function to add a measurement from its parts, used when loading files so no measurement object is built
+template <class V> void measurementColumns<V>::push_back(const V & value, const V & error, const V & systError,
+	string_view unit, const timestamp & time) {
+	values.push_back(value); errors.push_back(error); systErrors.push_back(systError);
+	times.push_back(time);
+	if (!unitCodes.empty()) { unitCodes.push_back(0); }
+	setUnitCode(values.size() - 1, getUnitCode(unit));
+}
+
+// Function to overwrite an existing measurement
+template <class V> void measurementColumns<V>::set(const size_t & index, const measurement<V> & mes) {
+	setEntry(values, index, mes.getValue()); setEntry(errors, index, mes.getError()); setEntry(systErrors, index, mes.getSystError());
+	times[index] = mes.getTime();
+	setUnitCode(index, getUnitCode(mes.getUnit()));
+}
+
+// Function to rebuild a full measurement from the columns
+template <class V> measurement<V> measurementColumns<V>::get(const size_t & index) const {
+	return (measurement<V>{ values[index], errors[index], systErrors[index], getUnit(index), times[index] });
+}
+
+// Accesor function for the unit of a measurement
+template <class V> const string & measurementColumns<V>::getUnit(const size_t & index) const {
+	static const string noUnit{ "N/A" };
+	if (units.empty()) { return (noUnit); }
+	if (unitCodes.empty()) { return (units[0]); }
+	return (units[unitCodes[index]]);
+}
+
+// Number of bytes allocated by the columns
+template <class V> size_t measurementColumns<V>::getMemoryUsage() const {
+	size_t output{ 0 };
+	output += getColumnMemory(values) + getColumnMemory(errors) + getColumnMemory(systErrors);
+	output += times.capacity() * sizeof(timestamp);
+	output += unitCodes.capacity() * sizeof(unsigned short) + units.capacity() * sizeof(string);
+	return (output);
+}
+
+// Function to write the unit table and every column to a binary save file
+// The unitCodes column is only written if there is more than one unit, with a byte before it saying if it is there
+template <class V> void measurementColumns<V>::writeBinary(binaryWriter & output) const {
+	output.writeVarint(units.size());
+	for (size_t i{ 0 }; i < units.size(); i++) { output.writeString(units[i]); }
+	output.writeColumn(values); output.writeColumn(errors); output.writeColumn(systErrors);
+	output.writeColumn(times);
+	output.writeNumber((unsigned char)(unitCodes.empty() ? 0 : 1));
+	output.writeNumbers(unitCodes.data(), unitCodes.size());
+}
+
+// Function to replace the columns with count measurements read from a binary save file
+template <class V> bool measurementColumns<V>::readBinary(binaryReader & input, const size_t & count) {
+	uint64_t unitCount;
+	string_view unit;
+	if (!input.readVarint(unitCount) || unitCount > 0x10000 || unitCount > input.getRemaining()) { return (false); }
+	units.clear();
+	for (size_t i{ 0 }; i < unitCount; i++) {
+		if (!input.readString(unit)) { return (false); }
+		units.emplace_back(unit);
+	}
+	if (!input.readColumn(values, count) || !input.readColumn(errors, count) || !input.readColumn(systErrors, count)) { return (false); }
+	if (!input.readColumn(times, count)) { return (false); }
+	unsigned char hasUnitCodes;
+	if (!input.readNumber(hasUnitCodes) || hasUnitCodes > 1) { return (false); }
+	unitCodes.clear();
+	if (hasUnitCodes == 1) {
+		if (count > input.getRemaining() / sizeof(unsigned short)) { return (false); }
+		unitCodes.resize(count);
+		if (!input.readNumbers(unitCodes.data(), count)) { return (false); }
+		for (size_t i{ 0 }; i < count; i++) {
+			if (unitCodes[i] >= units.size()) { return (false); }
+		}
+	}
+	// Every measurement has a unit, so the table can only be empty if there are no measurements
+	return (count == 0 || !units.empty());
+}
+
+#endif
@@ -0,0 +1,109 @@
+// This file contains the definitions for the quantileSketchClass.h file
+
+using namespace std;
+#include<vector>
+#include<algorithm>
+#include<utility>
+#include<cmath>
+#include<limits>
+
+#include"quantileSketchClass.h"
+
+// Paramatrised constructor
+quantileSketch::quantileSketch(const size_t & size) : maxSize{ max(size, size_t(8)) }, levels(1), count{ 0 },
+	minValue{ numeric_limits<double>::infinity() }, maxValue{ -numeric_limits<double>::infinity() } {
+	updateCapacities();
+}
+
+// Function to find the capacity of every level. Each level below the top keeps 2/3 as many as the one above, and never less than 2
+void quantileSketch::updateCapacities() {
+	capacities.resize(levels.size());
+	keepSecond.resize(levels.size(), false);
+	for (size_t level{ 0 }; level < levels.size(); level++) {
+		double capacity{ double(maxSize) * pow(2.0 / 3.0, double(levels.size() - 1 - level)) };
+		capacities[level] = capacity > 2 ? size_t(ceil(capacity)) : 2;
+	}
+}
+
+// Function to compact any levels which are full, starting from the bottom
+void quantileSketch::compress() {
+	for (size_t level{ 0 }; level < levels.size(); level++) {
+		if (levels[level].size() < capacities[level]) { continue; }
+		if (level + 1 == levels.size()) { levels.push_back(vector<double>{}); updateCapacities(); }
+		// Sort the level and move half of it up. With an odd number the largest number stays, so no weight is lost
+		vector<double> & current{ levels[level] };
+		sort(current.begin(), current.end());
+		size_t pairs{ current.size() / 2 };
+		for (size_t i{ 0 }; i < pairs; i++) { levels[level + 1].push_back(current[2 * i + (keepSecond[level] ? 1 : 0)]); }
+		keepSecond[level] = !keepSecond[level];
+		if (current.size() % 2 == 1) { current[0] = current.back(); current.resize(1); }
+		else { current.clear(); }
+	}
+}
+
+// Function to add a number
+void quantileSketch::add(const double & value) {
+	count++;
+	minValue = value < minValue ? value : minValue;
+	maxValue = value > maxValue ? value : maxValue;
+	levels[0].push_back(value);
+	if (levels[0].size() >= capacities[0]) { compress(); }
+}
+
+// Function to add everything in another sketch to this one
+void quantileSketch::merge(const quantileSketch & sketch) {
+	if (sketch.count == 0) { return; }
+	count += sketch.count;
+	minValue = sketch.minValue < minValue ? sketch.minValue : minValue;
+	maxValue = sketch.maxValue > maxValue ? sketch.maxValue : maxValue;
+	if (sketch.levels.size() > levels.size()) { levels.resize(sketch.levels.size()); updateCapacities(); }
+	for (size_t level{ 0 }; level < sketch.levels.size(); level++) {
+		levels[level].insert(levels[level].end(), sketch.levels[level].begin(), sketch.levels[level].end());
+	}
+	compress();
+}
+
+// Function to remove every number
+void quantileSketch::clear() {
+	levels.assign(1, vector<double>{});
+	keepSecond.clear();
+	updateCapacities();
+	count = 0;
+	minValue = numeric_limits<double>::infinity(); maxValue = -numeric_limits<double>::infinity();
+}
+
+// Function returning the approximate quantile q of the numbers added
+double quantileSketch::getQuantile(const double & q) const {
+	return (getQuantiles(vector<double>{ q })[0]);
+}
+
+// Function returning several quantiles at once
+vector<double> quantileSketch::getQuantiles(const vector<double> & qs) const {
+	vector<double> output(qs.size(), numeric_limits<double>::quiet_NaN());
+	if (count == 0) { return (output); }
+	// Sort the numbers kept with their weights, then find the first number whose total weight reaches each rank
+	vector<pair<double, size_t>> sample;
+	for (size_t level{ 0 }; level < levels.size(); level++) {
+		for (size_t i{ 0 }; i < levels[level].size(); i++) { sample.push_back(pair<double, size_t>{ levels[level][i], size_t(1) << level }); }
+	}
+	sort(sample.begin(), sample.end());
+	for (size_t i{ 0 }; i < qs.size(); i++) {
+		if (!(qs[i] > 0)) { output[i] = minValue; continue; }
+		if (!(qs[i] < 1)) { output[i] = maxValue; continue; }
+		double rank{ qs[i] * double(count) };
+		size_t total{ 0 };
+		output[i] = maxValue;
+		for (size_t j{ 0 }; j < sample.size(); j++) {
+			total += sample[j].second;
+			if (double(total) >= rank) { output[i] = sample[j].first; break; }
+		}
+	}
+	return (output);
+}
+
+// Number of bytes allocated by the sketch
+size_t quantileSketch::getMemoryUsage() const {
+	size_t output{ levels.capacity() * sizeof(vector<double>) + capacities.capacity() * sizeof(size_t) + keepSecond.capacity() / 8 };
+	for (size_t level{ 0 }; level < levels.size(); level++) { output += levels[level].capacity() * sizeof(double); }
+	return (output);
+}
@@ -0,0 +1,64 @@
+// This header contains the quantileSketch class. This keeps a small sample of a stream of numbers, from which any quantile
+// (median, percentiles, etc.) can be found approximately without keeping or sorting every number
+// Functions defined in the quantileSketchClass.cpp file
+
+#ifndef QUANTILE_SKETCH_CLASS_H
+#define QUANTILE_SKETCH_CLASS_H
+
+using namespace std;
+#include<vector>
+#include<cstddef>
+
+// Class for a quantile sketch in the style of KLL. Numbers are added to level 0, and when a level is full it is sorted and every
+// other number is moved up to the next level, where each number stands for twice as many. Lower levels are given less space,
+// so the memory used only grows with the log of the count of numbers
+// The half kept by each level alternates between the first and second numbers, rather than being random, so results are reproducible
+class quantileSketch {
+private:
+	// Most numbers kept by the top level. Bigger sketches are more accurate (A size of 200 finds ranks to within about 1.5%)
+	size_t maxSize;
+	// Numbers kept at each level. A number at level h stands for 2^h of the numbers added
+	vector<vector<double>> levels;
+	// Most numbers each level can keep before it is compacted. This only changes when a level is added
+	vector<size_t> capacities;
+	// Count of numbers added and the smallest and largest of them, which are kept exactly
+	size_t count;
+	double minValue, maxValue;
+	// Which half of each level is kept the next time it is compacted
+	vector<bool> keepSecond;
+
+	// Function to find the capacity of every level, after the number of levels has changed
+	void updateCapacities();
+
+	// Function to compact any levels which are full, starting from the bottom
+	void compress();
+
+public:
+	// Paramatrised constructor. size is the most numbers kept by the top level (At least 8)
+	quantileSketch(const size_t & size = 200);
+
+	// Function to add a number
+	void add(const double & value);
+
+	// Function to add everything in another sketch to this one, as if its numbers had been added here
+	void merge(const quantileSketch & sketch);
+
+	// Function to remove every number
+	void clear();
+
+	// Accesor functions
+	size_t size() const { return (count); }
+	bool empty() const { return (count == 0); }
+	size_t getMaxSize() const { return (maxSize); }
+
+	// Function returning the approximate quantile q (Between 0 and 1) of the numbers added. 0 and 1 give the exact minimum and maximum
+	double getQuantile(const double & q) const;
+
+	// Function returning several quantiles at once, which only needs the sample to be sorted once
+	vector<double> getQuantiles(const vector<double> & qs) const;
+
+	// Number of bytes allocated by the sketch
+	size_t getMemoryUsage() const;
+};
+
+#endif
@@ -0,0 +1,522 @@
+// This file contains the definitions for the statisticsHeader.h file
+
+using namespace std;
+#include<string>
+#include<iostream>
+#include<cmath>
+#include<limits>
+#include<algorithm>
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<functional>
+
+#include"statisticsHeader.h"
+
+// Check which vector instructions can be used with this compiler
+// AVX2 functions need a target attribute with gcc and clang, while MSVC accepts the intrinsics anywhere
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include<immintrin.h>
+#define STATISTICS_X86
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include<immintrin.h>
+#include<intrin.h>
+#define STATISTICS_X86
+#define SSE2_TARGET
+#define AVX2_TARGET
+#endif
+
+// Every version of the kernel splits the data in to 4 lanes (value i goes to lane i % 4), runs Welford's algorithm on
+// each lane, then merges the lanes and adds the last count % 4 values. The first value is subtracted from every value
+// before the mean and variance are found, so large values with a small spread don't lose precision. This keeps the
+// sums numerically stable for very large experiments, and the scalar and vector versions do identical arithmetic
+namespace {
+	const size_t numberOfLanes{ 4 };
+
+	// Function to find the value subtracted from the data before the mean and variance are found
+	double getShift(const double* values, const double* offsets, const size_t & count) {
+		return (count != 0 ? values[0] + offsets[0] : 0);
+	}
+
+	// Function to merge the lanes, add the leftover values at the end of the data and undo the shift
+	dataSummary finishSummary(const double* mean, const double* m2, const double* min, const double* max, const size_t & blocks,
+		const double* values, const double* offsets, const size_t & count, const double & shift) {
+		dataSummary output{ emptySummary };
+		if (blocks != 0) {
+			for (size_t lane{ 0 }; lane < numberOfLanes; lane++) {
+				output = mergeSummaries(output, dataSummary{ blocks, mean[lane], m2[lane], min[lane], max[lane] });
+			}
+		}
+		for (size_t i{ blocks * numberOfLanes }; i < count; i++) {
+			double x{ values[i] + offsets[i] };
+			double shifted{ x - shift };
+			output.count++;
+			double delta{ shifted - output.mean };
+			output.mean += delta * (1 / double(output.count));
+			output.m2 += delta * (shifted - output.mean);
+			output.min = x < output.min ? x : output.min;
+			output.max = x > output.max ? x : output.max;
+		}
+		output.mean += shift;
+		return (output);
+	}
+
+	// Scalar version of the kernel, used when no vector instructions are available
+	dataSummary summariseScalar(const double* values, const double* offsets, const size_t & count) {
+		double mean[numberOfLanes]{}, m2[numberOfLanes]{}, min[numberOfLanes], max[numberOfLanes];
+		for (size_t lane{ 0 }; lane < numberOfLanes; lane++) {
+			min[lane] = numeric_limits<double>::infinity(); max[lane] = -numeric_limits<double>::infinity();
+		}
+		const double shift{ getShift(values, offsets, count) };
+		size_t blocks{ count / numberOfLanes };
+		for (size_t k{ 1 }; k <= blocks; k++) {
+			const size_t start{ (k - 1) * numberOfLanes };
+			const double inverseK{ 1 / double(k) };
+			for (size_t lane{ 0 }; lane < numberOfLanes; lane++) {
+				double x{ values[start + lane] + offsets[start + lane] };
+				double shifted{ x - shift };
+				double delta{ shifted - mean[lane] };
+				mean[lane] += delta * inverseK;
+				m2[lane] += delta * (shifted - mean[lane]);
+				min[lane] = x < min[lane] ? x : min[lane];
+				max[lane] = x > max[lane] ? x : max[lane];
+			}
+		}
+		return (finishSummary(mean, m2, min, max, blocks, values, offsets, count, shift));
+	}
+
+#ifdef STATISTICS_X86
+	// SSE2 version of the kernel. Each register holds 2 lanes, so two registers are used for the 4 lanes
+	SSE2_TARGET dataSummary summariseSSE2(const double* values, const double* offsets, const size_t & count) {
+		__m128d meanLow{ _mm_setzero_pd() }, meanHigh{ _mm_setzero_pd() }, m2Low{ _mm_setzero_pd() }, m2High{ _mm_setzero_pd() };
+		__m128d minLow{ _mm_set1_pd(numeric_limits<double>::infinity()) }, minHigh{ minLow };
+		__m128d maxLow{ _mm_set1_pd(-numeric_limits<double>::infinity()) }, maxHigh{ maxLow };
+		const double shift{ getShift(values, offsets, count) };
+		const __m128d shiftLanes{ _mm_set1_pd(shift) };
+		size_t blocks{ count / numberOfLanes };
+		for (size_t k{ 1 }; k <= blocks; k++) {
+			const size_t start{ (k - 1) * numberOfLanes };
+			const __m128d inverseK{ _mm_set1_pd(1 / double(k)) };
+			__m128d xLow{ _mm_add_pd(_mm_loadu_pd(values + start), _mm_loadu_pd(offsets + start)) };
+			__m128d xHigh{ _mm_add_pd(_mm_loadu_pd(values + start + 2), _mm_loadu_pd(offsets + start + 2)) };
+			__m128d shiftedLow{ _mm_sub_pd(xLow, shiftLanes) }, shiftedHigh{ _mm_sub_pd(xHigh, shiftLanes) };
+			__m128d deltaLow{ _mm_sub_pd(shiftedLow, meanLow) }, deltaHigh{ _mm_sub_pd(shiftedHigh, meanHigh) };
+			meanLow = _mm_add_pd(meanLow, _mm_mul_pd(deltaLow, inverseK));
+			meanHigh = _mm_add_pd(meanHigh, _mm_mul_pd(deltaHigh, inverseK));
+			m2Low = _mm_add_pd(m2Low, _mm_mul_pd(deltaLow, _mm_sub_pd(shiftedLow, meanLow)));
+			m2High = _mm_add_pd(m2High, _mm_mul_pd(deltaHigh, _mm_sub_pd(shiftedHigh, meanHigh)));
+			minLow = _mm_min_pd(xLow, minLow); minHigh = _mm_min_pd(xHigh, minHigh);
+			maxLow = _mm_max_pd(xLow, maxLow); maxHigh = _mm_max_pd(xHigh, maxHigh);
+		}
+		double mean[numberOfLanes], m2[numberOfLanes], min[numberOfLanes], max[numberOfLanes];
+		_mm_storeu_pd(mean, meanLow); _mm_storeu_pd(mean + 2, meanHigh);
+		_mm_storeu_pd(m2, m2Low); _mm_storeu_pd(m2 + 2, m2High);
+		_mm_storeu_pd(min, minLow); _mm_storeu_pd(min + 2, minHigh);
+		_mm_storeu_pd(max, maxLow); _mm_storeu_pd(max + 2, maxHigh);
+		return (finishSummary(mean, m2, min, max, blocks, values, offsets, count, shift));
+	}
+
+	// AVX2 version of the kernel. One register holds all 4 lanes
+	AVX2_TARGET dataSummary summariseAVX2(const double* values, const double* offsets, const size_t & count) {
+		__m256d meanLanes{ _mm256_setzero_pd() }, m2Lanes{ _mm256_setzero_pd() };
+		__m256d minLanes{ _mm256_set1_pd(numeric_limits<double>::infinity()) };
+		__m256d maxLanes{ _mm256_set1_pd(-numeric_limits<double>::infinity()) };
+		const double shift{ getShift(values, offsets, count) };
+		const __m256d shiftLanes{ _mm256_set1_pd(shift) };
+		size_t blocks{ count / numberOfLanes };
+		for (size_t k{ 1 }; k <= blocks; k++) {
+			const size_t start{ (k - 1) * numberOfLanes };
+			__m256d x{ _mm256_add_pd(_mm256_loadu_pd(values + start), _mm256_loadu_pd(offsets + start)) };
+			__m256d shifted{ _mm256_sub_pd(x, shiftLanes) };
+			__m256d delta{ _mm256_sub_pd(shifted, meanLanes) };
+			meanLanes = _mm256_add_pd(meanLanes, _mm256_mul_pd(delta, _mm256_set1_pd(1 / double(k))));
+			m2Lanes = _mm256_add_pd(m2Lanes, _mm256_mul_pd(delta, _mm256_sub_pd(shifted, meanLanes)));
+			minLanes = _mm256_min_pd(x, minLanes);
+			maxLanes = _mm256_max_pd(x, maxLanes);
+		}
+		double mean[numberOfLanes], m2[numberOfLanes], min[numberOfLanes], max[numberOfLanes];
+		_mm256_storeu_pd(mean, meanLanes); _mm256_storeu_pd(m2, m2Lanes);
+		_mm256_storeu_pd(min, minLanes); _mm256_storeu_pd(max, maxLanes);
+		return (finishSummary(mean, m2, min, max, blocks, values, offsets, count, shift));
+	}
+
+	// Functions to check if the processor (and operating system) support SSE2 and AVX2
+	bool supportsSSE2() {
+#if defined(__GNUC__)
+		__builtin_cpu_init();
+		return (__builtin_cpu_supports("sse2") != 0);
+#else
+		int info[4];
+		__cpuid(info, 1);
+		return ((info[3] & (1 << 26)) != 0);
+#endif
+	}
+	bool supportsAVX2() {
+#if defined(__GNUC__)
+		__builtin_cpu_init();
+		return (__builtin_cpu_supports("avx2") != 0);
+#else
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) { return (false); }
+		// Check the operating system saves the AVX registers
+		__cpuid(info, 1);
+		bool osSupport{ (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 };
+		if (!osSupport || (_xgetbv(0) & 6) != 6) { return (false); }
+		__cpuidex(info, 7, 0);
+		return ((info[1] & (1 << 5)) != 0);
+#endif
+	}
+#endif
+
+	// Type of all the kernel functions, and the structure recording which one was chosen
+	typedef dataSummary(*summaryKernel)(const double*, const double*, const size_t &);
+	struct kernelChoice {
+		summaryKernel kernel;
+		string name;
+	};
+
+	// Function to list the kernels this processor can run, fastest first. Only called once
+	vector<kernelChoice> findKernels() {
+		vector<kernelChoice> output;
+#ifdef STATISTICS_X86
+		if (supportsAVX2()) { output.push_back(kernelChoice{ summariseAVX2, "AVX2" }); }
+		if (supportsSSE2()) { output.push_back(kernelChoice{ summariseSSE2, "SSE2" }); }
+#endif
+		output.push_back(kernelChoice{ summariseScalar, "scalar" });
+		return (output);
+	}
+	const vector<kernelChoice> & getAvailableKernels() {
+		static const vector<kernelChoice> availableKernels{ findKernels() };
+		return (availableKernels);
+	}
+
+	// Position in the available kernels of the kernel being used. The fastest is used unless another is chosen
+	atomic<size_t> kernelIndex{ 0 };
+
+	// Accesor function for the kernel being used
+	const kernelChoice & getKernel() {
+		return (getAvailableKernels()[kernelIndex.load()]);
+	}
+
+	// Number of values in each chunk of data. This must not depend on the number of threads, so results are reproducible
+	const size_t chunkSize{ size_t(1) << 16 };
+
+	// Most partial summaries or bin counts kept at once (One for each group or bin in each chunk)
+	const size_t maxGroupSummaries{ size_t(1) << 20 };
+
+	// Number of fixed bins in the finer histogram used for each quantile bin
+	const size_t quantileResolution{ 256 };
+
+	// Number of bins and binning used for the distribution of numeric experiments
+	atomic<size_t> histogramBins{ 10 };
+	atomic<binningType> histogramBinning{ fixedBins };
+
+	// Size of the quantile sketches kept by numeric experiments
+	atomic<size_t> sketchSize{ 200 };
+
+	// Number of threads used by the statistics functions
+	atomic<size_t> statisticsThreads{ thread::hardware_concurrency() != 0 ? thread::hardware_concurrency() : 1 };
+
+	// Fewest chunks for each thread started. Starting a thread costs about as much as a small chunk of work, so data that is only a
+	// few chunks long (Such as the rows added since the last fit) is done on the calling thread without starting any
+	const size_t minChunksPerThread{ 4 };
+
+	// Function to call chunkFunction for every chunk number from 0 to numberOfChunks - 1, shared between threads
+	// Each thread takes the next chunk that hasn't been started, so the work is balanced even if some chunks are slower
+	void runChunks(const size_t & numberOfChunks, const function<void(size_t)> & chunkFunction) {
+		size_t threadCount{ min(statisticsThreads.load(), numberOfChunks / minChunksPerThread) };
+		if (threadCount <= 1) {
+			for (size_t chunk{ 0 }; chunk < numberOfChunks; chunk++) { chunkFunction(chunk); }
+			return;
+		}
+		atomic<size_t> nextChunk{ 0 };
+		auto worker = [&nextChunk, &numberOfChunks, &chunkFunction]() {
+			for (size_t chunk{ nextChunk++ }; chunk < numberOfChunks; chunk = nextChunk++) { chunkFunction(chunk); }
+		};
+		// The current thread also does work, so only threadCount - 1 extra threads are needed
+		vector<thread> threads;
+		for (size_t i{ 1 }; i < threadCount; i++) { threads.push_back(thread(worker)); }
+		worker();
+		for (size_t i{ 0 }; i < threads.size(); i++) { threads[i].join(); }
+	}
+
+	// Number of chunks needed for some data
+	size_t getNumberOfChunks(const size_t & count) {
+		return ((count + chunkSize - 1) / chunkSize);
+	}
+
+	// Function to count the values in each bin, where binOf gives the bin of a value. Each chunk is counted on its own and the counts
+	// are added at the end. Like summariseGroups, fewer and larger chunks are used when there are many bins
+	template <class BinFunction> vector<size_t> countBins(const double* values, const size_t & count, const size_t & bins,
+		const BinFunction & binOf) {
+		size_t numberOfChunks{ min(getNumberOfChunks(count), max(size_t(1), maxGroupSummaries / bins)) };
+		size_t valuesPerChunk{ (count + numberOfChunks - 1) / numberOfChunks };
+		vector<vector<size_t>> chunkCounts(numberOfChunks);
+		runChunks(numberOfChunks, [&](size_t chunk) {
+			vector<size_t> counts(bins, 0);
+			size_t end{ min(count, (chunk + 1) * valuesPerChunk) };
+			for (size_t i{ chunk * valuesPerChunk }; i < end; i++) { counts[binOf(values[i])]++; }
+			chunkCounts[chunk] = move(counts);
+		});
+		vector<size_t> output(bins, 0);
+		for (size_t chunk{ 0 }; chunk < numberOfChunks; chunk++) {
+			for (size_t i{ 0 }; i < bins; i++) { output[i] += chunkCounts[chunk][i]; }
+		}
+		return (output);
+	}
+
+	// Function to find the bin of a value at some position along the bins (0 at the first edge, bins at the last)
+	// Values on an edge go in the bin below it, and the smallest value goes in the first bin
+	size_t positionToBin(const double & position, const size_t & bins) {
+		if (!(position > 1)) { return (0); }
+		double bin{ ceil(position) - 1 };
+		return (bin < double(bins) ? size_t(bin) : bins - 1);
+	}
+}
+
+// Sample standard deviation
+double dataSummary::getStandardDeviation() const {
+	return (sqrt(getVariance()));
+}
+
+// Error on the mean
+double dataSummary::getErrorOnMean() const {
+	return (getStandardDeviation() / sqrt(double(count)));
+}
+
+// A function to combine the summaries of two sets of data in to the summary of both (Chan et al. pairwise update)
+dataSummary mergeSummaries(const dataSummary & first, const dataSummary & second) {
+	if (first.count == 0) { return (second); }
+	if (second.count == 0) { return (first); }
+	dataSummary output;
+	double firstCount{ double(first.count) }, secondCount{ double(second.count) };
+	output.count = first.count + second.count;
+	double totalCount{ double(output.count) };
+	double delta{ second.mean - first.mean };
+	output.mean = first.mean + delta * (secondCount / totalCount);
+	output.m2 = first.m2 + second.m2 + delta * delta * (firstCount * secondCount / totalCount);
+	output.min = second.min < first.min ? second.min : first.min;
+	output.max = second.max > first.max ? second.max : first.max;
+	return (output);
+}
+
+// A function to find the count, mean, variance, min and max of values[i] + offsets[i] in a single pass
+dataSummary summariseData(const double* values, const double* offsets, const size_t & count) {
+	if (count <= chunkSize) { return (getKernel().kernel(values, offsets, count)); }
+	// Summarise each chunk, then merge them in order
+	vector<dataSummary> chunkSummaries(getNumberOfChunks(count));
+	runChunks(chunkSummaries.size(), [&](size_t chunk) {
+		size_t start{ chunk * chunkSize };
+		chunkSummaries[chunk] = getKernel().kernel(values + start, offsets + start, min(chunkSize, count - start));
+	});
+	dataSummary output{ chunkSummaries[0] };
+	for (size_t i{ 1 }; i < chunkSummaries.size(); i++) { output = mergeSummaries(output, chunkSummaries[i]); }
+	return (output);
+}
+
+// A function to find the summary of values[i] + offsets[i] for each group of values
+vector<dataSummary> summariseGroups(const double* values, const double* offsets, const uint32_t* groups, const size_t & count,
+	const size_t & groupCount) {
+	if (groupCount == 0) { return (vector<dataSummary>{}); }
+	// Every chunk needs a summary for each group, so with many groups fewer and larger chunks are used to limit the memory needed
+	// The number of chunks still only depends on the data
+	size_t numberOfChunks{ min(getNumberOfChunks(count), max(size_t(1), maxGroupSummaries / groupCount)) };
+	size_t valuesPerChunk{ numberOfChunks != 0 ? (count + numberOfChunks - 1) / numberOfChunks : 0 };
+	vector<vector<dataSummary>> chunkSummaries(numberOfChunks);
+	runChunks(numberOfChunks, [&](size_t chunk) {
+		vector<dataSummary> summaries(groupCount, emptySummary);
+		size_t end{ min(count, (chunk + 1) * valuesPerChunk) };
+		for (size_t i{ chunk * valuesPerChunk }; i < end; i++) {
+			summaries[groups != NULL ? groups[i] : 0].add(values[i] + offsets[i]);
+		}
+		chunkSummaries[chunk] = move(summaries);
+	});
+	// Merge the chunks in order
+	vector<dataSummary> output(groupCount, emptySummary);
+	for (size_t chunk{ 0 }; chunk < numberOfChunks; chunk++) {
+		for (size_t i{ 0 }; i < groupCount; i++) { output[i] = mergeSummaries(output[i], chunkSummaries[chunk][i]); }
+	}
+	return (output);
+}
+
+// A function to build a quantile sketch of values plus offsets, sketching each chunk on the threads and merging the sketches in order
+quantileSketch sketchData(const double* values, const double* offsets, const size_t & count, const size_t & size) {
+	vector<quantileSketch> chunkSketches(getNumberOfChunks(count), quantileSketch{ size });
+	runChunks(chunkSketches.size(), [&](size_t chunk) {
+		size_t end{ min(count, (chunk + 1) * chunkSize) };
+		for (size_t i{ chunk * chunkSize }; i < end; i++) { chunkSketches[chunk].add(values[i] + offsets[i]); }
+	});
+	quantileSketch output{ size };
+	for (size_t i{ 0 }; i < chunkSketches.size(); i++) { output.merge(chunkSketches[i]); }
+	return (output);
+}
+
+// A function to find the weighted sums used in a linear fit, using the same chunks and threads as summariseData
+weightedSums summariseWeightedData(const double* x, const double* y, const double* w, const size_t & count) {
+	vector<weightedSums> chunkSums(getNumberOfChunks(count), weightedSums{ 0, 0, 0, 0, 0 });
+	runChunks(chunkSums.size(), [&](size_t chunk) {
+		// Sum in a local variable, so threads don't write to the same cache line on every value
+		weightedSums sums{ 0, 0, 0, 0, 0 };
+		size_t end{ min(count, (chunk + 1) * chunkSize) };
+		for (size_t i{ chunk * chunkSize }; i < end; i++) {
+			sums.sumW += w[i];
+			sums.sumWX += w[i] * x[i];
+			sums.sumWXX += w[i] * x[i] * x[i];
+			sums.sumWY += w[i] * y[i];
+			sums.sumWXY += w[i] * x[i] * y[i];
+		}
+		chunkSums[chunk] = sums;
+	});
+	// Add the chunks together in order
+	weightedSums output{ 0, 0, 0, 0, 0 };
+	for (size_t i{ 0 }; i < chunkSums.size(); i++) {
+		output.sumW += chunkSums[i].sumW; output.sumWX += chunkSums[i].sumWX; output.sumWXX += chunkSums[i].sumWXX;
+		output.sumWY += chunkSums[i].sumWY; output.sumWXY += chunkSums[i].sumWXY;
+	}
+	return (output);
+}
+
+// A function to find the weighted sums of the residuals of a line, using the same chunks and threads as summariseData
+residualSums summariseResiduals(const double* x, const double* y, const double* w, const size_t & count, const double & gradient,
+	const double & intercept) {
+	vector<residualSums> chunkSums(getNumberOfChunks(count), residualSums{ 0, 0, 0 });
+	runChunks(chunkSums.size(), [&](size_t chunk) {
+		residualSums sums{ 0, 0, 0 };
+		size_t end{ min(count, (chunk + 1) * chunkSize) };
+		for (size_t i{ chunk * chunkSize }; i < end; i++) {
+			double residual{ y[i] - (gradient * x[i] + intercept) };
+			sums.sumWRR += w[i] * residual * residual;
+			sums.sumWRX += w[i] * residual * x[i];
+			sums.sumWR += w[i] * residual;
+		}
+		chunkSums[chunk] = sums;
+	});
+	// Add the chunks together in order
+	residualSums output{ 0, 0, 0 };
+	for (size_t i{ 0 }; i < chunkSums.size(); i++) {
+		output.sumWRR += chunkSums[i].sumWRR; output.sumWRX += chunkSums[i].sumWRX; output.sumWR += chunkSums[i].sumWR;
+	}
+	return (output);
+}
+
+// A function to put values in to a histogram with the given number of bins, without copying or sorting the values
+histogram makeHistogram(const double* values, const size_t & count, const size_t & bins, const binningType & binning) {
+	histogram output{ vector<double>{}, vector<size_t>{}, binning };
+	if (count == 0 || bins == 0) { return (output); }
+
+	// Find the smallest and largest values
+	vector<pair<double, double>> chunkRanges(getNumberOfChunks(count));
+	runChunks(chunkRanges.size(), [&](size_t chunk) {
+		pair<double, double> range{ values[chunk * chunkSize], values[chunk * chunkSize] };
+		size_t end{ min(count, (chunk + 1) * chunkSize) };
+		for (size_t i{ chunk * chunkSize }; i < end; i++) {
+			range.first = values[i] < range.first ? values[i] : range.first;
+			range.second = values[i] > range.second ? values[i] : range.second;
+		}
+		chunkRanges[chunk] = range;
+	});
+	double minValue{ chunkRanges[0].first }, maxValue{ chunkRanges[0].second };
+	for (size_t i{ 1 }; i < chunkRanges.size(); i++) {
+		minValue = min(minValue, chunkRanges[i].first);
+		maxValue = max(maxValue, chunkRanges[i].second);
+	}
+	if (output.binning == logBins && !(minValue > 0)) { output.binning = fixedBins; }
+
+	if (output.binning == logBins) {
+		double logWidth{ log(maxValue / minValue) / double(bins) };
+		for (size_t i{ 0 }; i < bins; i++) { output.edges.push_back(minValue * exp(double(i) * logWidth)); }
+		output.edges.push_back(maxValue);
+		output.counts = countBins(values, count, bins, [&](const double & x) {
+			return (logWidth > 0 ? positionToBin(log(x / minValue) / logWidth, bins) : 0);
+		});
+		return (output);
+	}
+
+	// Fixed bins, or the finer fixed bins the quantile bins are made from
+	size_t fixedCount{ output.binning == quantileBins ? bins * quantileResolution : bins };
+	double width{ (maxValue - minValue) / double(fixedCount) };
+	vector<size_t> fixedCounts{ countBins(values, count, fixedCount, [&](const double & x) {
+		return (width > 0 ? positionToBin((x - minValue) / width, fixedCount) : 0);
+	}) };
+	if (output.binning == fixedBins) {
+		for (size_t i{ 0 }; i < bins; i++) { output.edges.push_back(minValue + i*width); }
+		output.edges.push_back(maxValue);
+		output.counts = move(fixedCounts);
+		return (output);
+	}
+
+	// Close each quantile bin at the first fine edge where it holds its share of the values
+	output.edges.push_back(minValue);
+	// If one fine bin holds the share of several quantile bins they become one bin, so the next bin aims for the next share
+	size_t total{ 0 }, binCount{ 0 }, nextShare{ 1 };
+	for (size_t i{ 0 }; i < fixedCount; i++) {
+		total += fixedCounts[i];
+		binCount += fixedCounts[i];
+		if (binCount != 0 && (i == fixedCount - 1 || double(total) * double(bins) >= double(count) * double(nextShare))) {
+			output.edges.push_back(i == fixedCount - 1 ? maxValue : minValue + (i + 1)*width);
+			output.counts.push_back(binCount);
+			binCount = 0;
+			nextShare = size_t(double(total) * double(bins) / double(count)) + 1;
+		}
+	}
+	return (output);
+}
+
+// Accesor and mutator functions for the number of threads used by the statistics functions
+size_t getStatisticsThreads() {
+	return (statisticsThreads.load());
+}
+void setStatisticsThreads(const size_t & threads) {
+	statisticsThreads = (threads != 0 ? threads : 1);
+}
+
+// Accesor and mutator functions for the number of bins and the binning used for the distribution of numeric experiments
+size_t getHistogramBins() {
+	return (histogramBins.load());
+}
+binningType getHistogramBinning() {
+	return (histogramBinning.load());
+}
+void setHistogramBins(const size_t & bins, const binningType & binning) {
+	histogramBins = (bins != 0 ? bins : 1);
+	histogramBinning = binning;
+}
+
+// Accesor and mutator functions for the size of the quantile sketches kept by numeric experiments
+size_t getSketchSize() {
+	return (sketchSize.load());
+}
+void setSketchSize(const size_t & size) {
+	sketchSize = size;
+}
+
+// Name of a way of choosing bins
+string getBinningName(const binningType & binning) {
+	if (binning == quantileBins) { return ("quantile"); }
+	if (binning == logBins) { return ("log"); }
+	return ("fixed");
+}
+
+// Name of the version of summariseData being used on this processor
+string getStatisticsKernelName() {
+	return (getKernel().name);
+}
+
+// Names of the versions of summariseData this processor can run, fastest first
+vector<string> getStatisticsKernelNames() {
+	vector<string> output;
+	for (size_t i{ 0 }; i < getAvailableKernels().size(); i++) { output.push_back(getAvailableKernels()[i].name); }
+	return (output);
+}
+
+// Mutator function for the version of summariseData being used
+bool setStatisticsKernel(const string & name) {
+	for (size_t i{ 0 }; i < getAvailableKernels().size(); i++) {
+		if (getAvailableKernels()[i].name == name) { kernelIndex = i; return (true); }
+	}
+	cout << "Warning: The '" << name << "' statistics kernel can't be used on this processor." << endl;
+	return (false);
+}
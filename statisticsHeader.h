@@ -0,0 +1,127 @@
+// This header contains the statistics kernels used by numeric experiments
+// Functions defined in the statisticsHeader.cpp file
+// These functions only work on plain arrays of doubles, so they don't need to know about measurements or experiments
+
+#ifndef STATISTICS_HEADER_H
+#define STATISTICS_HEADER_H
+
+using namespace std;
+#include<string>
+#include<vector>
+#include<cstddef>
+#include<cstdint>
+#include<limits>
+#include"quantileSketchClass.h"
+
+// Structure holding everything found in a single pass over some data
+struct dataSummary {
+	size_t count;	// Number of values
+	double mean;	// Mean of the values
+	double m2;	// Sum of squared differences from the mean
+	double min, max;	// Smallest and largest values
+
+	// Sample variance, standard deviation and error on the mean
+	double getVariance() const { return (m2 / (count - 1)); }
+	double getStandardDeviation() const;
+	double getErrorOnMean() const;
+
+	// Function to add one value to the summary (Welford's algorithm)
+	void add(const double & x) {
+		count++;
+		double delta{ x - mean };
+		mean += delta / double(count);
+		m2 += delta * (x - mean);
+		min = x < min ? x : min;
+		max = x > max ? x : max;
+	}
+};
+
+// Summary of no values
+const dataSummary emptySummary{ 0, 0, 0, numeric_limits<double>::infinity(), -numeric_limits<double>::infinity() };
+
+// Ways the bins of a histogram can be chosen
+enum binningType : unsigned char {
+	fixedBins,	// Bins of equal width from the smallest to the largest value
+	quantileBins,	// Bins holding roughly equal numbers of values
+	logBins	// Bins of equal width in the log of the values. Only possible if every value is positive
+};
+
+// Structure holding a histogram. Bin i holds the values above edges[i] up to edges[i + 1], and the first bin also holds edges[0]
+struct histogram {
+	vector<double> edges;	// One more edge than bins, from the smallest to the largest value
+	vector<size_t> counts;	// Number of values in each bin
+	binningType binning;	// Way the bins were chosen
+};
+
+// Structure holding the weighted sums needed for a linear fit of y against x with weights w
+struct weightedSums {
+	double sumW, sumWX, sumWXX, sumWY, sumWXY;
+};
+
+// Structure holding the weighted sums of the residuals r = y - (gradient * x + intercept) of a line, used for the chi squared of a fit
+struct residualSums {
+	double sumWRR, sumWRX, sumWR;
+};
+
+// A function to combine the summaries of two sets of data in to the summary of both (Chan et al. pairwise update)
+dataSummary mergeSummaries(const dataSummary & first, const dataSummary & second);
+
+// A function to find the count, mean, variance, min and max of values[i] + offsets[i] in a single pass
+// Uses AVX2 or SSE2 when the processor supports them, chosen the first time the function is called. All versions
+// give exactly the same result, since they perform the same operations in the same order
+// The data is split in to fixed size chunks which are shared between threads and merged in order, so the result is
+// the same for any number of threads
+dataSummary summariseData(const double* values, const double* offsets, const size_t & count);
+
+// A function to find the summary of values[i] + offsets[i] for each group of values, in a single pass. groups[i] is the group of
+// value i (less than groupCount), or groups can be NULL if every value is in group 0
+// Each chunk of data is summarised per group on the threads, and the partial summaries are merged in order, so the result is
+// the same for any number of threads
+vector<dataSummary> summariseGroups(const double* values, const double* offsets, const uint32_t* groups, const size_t & count,
+	const size_t & groupCount);
+
+// A function to put values in to a histogram with the given number of bins, without copying or sorting the values
+// One pass finds the smallest and largest values and another counts the values in each bin, both shared between threads
+// Quantile bins are found from a finer histogram of fixed bins, so there can be fewer bins when many values are equal
+// Log bins can't be used if any value isn't positive, so fixed bins are used instead (The binning of the output says which was used)
+histogram makeHistogram(const double* values, const size_t & count, const size_t & bins, const binningType & binning);
+
+// A function to build a quantile sketch of values[i] + offsets[i] with the given size. Each chunk of data is sketched on the threads
+// and the sketches are merged in order, so the result is the same for any number of threads
+quantileSketch sketchData(const double* values, const double* offsets, const size_t & count, const size_t & size);
+
+// A function to find the weighted sums used in a linear fit, using the same chunks and threads as summariseData
+weightedSums summariseWeightedData(const double* x, const double* y, const double* w, const size_t & count);
+
+// A function to find the weighted sums of the residuals of the line gradient * x + intercept, using the same chunks and threads
+residualSums summariseResiduals(const double* x, const double* y, const double* w, const size_t & count, const double & gradient,
+	const double & intercept);
+
+// Accesor and mutator functions for the number of threads used by the statistics functions (Defaults to the number of cores)
+size_t getStatisticsThreads();
+void setStatisticsThreads(const size_t & threads);
+
+// Accesor and mutator functions for the number of bins and the binning used for the distribution of numeric experiments
+// (Defaults to 10 fixed bins)
+size_t getHistogramBins();
+binningType getHistogramBinning();
+void setHistogramBins(const size_t & bins, const binningType & binning);
+
+// Accesor and mutator functions for the size of the quantile sketches kept by numeric experiments (Defaults to 200)
+size_t getSketchSize();
+void setSketchSize(const size_t & size);
+
+// Name of a way of choosing bins ("fixed", "quantile" or "log")
+string getBinningName(const binningType & binning);
+
+// Name of the version of summariseData being used on this processor ("AVX2", "SSE2" or "scalar")
+string getStatisticsKernelName();
+
+// Names of the versions of summariseData this processor can run, fastest first. The fastest is used unless another is chosen
+vector<string> getStatisticsKernelNames();
+
+// Mutator function for the version of summariseData being used, given its name. Returns false if this processor can't run it
+// Every version gives exactly the same results, so this only changes the speed (Used to compare them)
+bool setStatisticsKernel(const string & name);
+
+#endif
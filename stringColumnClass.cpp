@@ -0,0 +1,67 @@
+// This file contains the definitions for the stringColumnClass.h file
+
+using namespace std;
+#include<string>
+#include<string_view>
+#include<vector>
+#include<algorithm>
+
+#include"stringColumnClass.h"
+
+// Default constructor
+stringColumn::stringColumn() : count{ 0 }, lastCode{ 0 } {}
+
+// Function to store the id of an entry, creating the codes once a second string is found
+void stringColumn::setCode(const size_t & index, const uint32_t & code) {
+	if (codes.empty()) {
+		if (code == 0) { return; }
+		codes.assign(count, 0);
+	}
+	codes[index] = code;
+}
+
+// Function returning the id of a string, adding it to the table if it is new
+uint32_t stringColumn::findCode(string_view text) {
+	if (lastCode < table.size() && table.getString(lastCode) == text) { return (lastCode); }
+	lastCode = table.add(text);
+	return (lastCode);
+}
+
+// Function to make space for a number of entries without adding them
+void stringColumn::reserve(const size_t & capacity) {
+	if (!codes.empty()) { codes.reserve(capacity); }
+}
+
+// Function to add an entry to the end of the column
+void stringColumn::push_back(string_view text) {
+	uint32_t code{ findCode(text) };
+	count++;
+	if (!codes.empty()) { codes.push_back(0); }
+	setCode(count - 1, code);
+}
+
+// Function to overwrite an existing entry
+void stringColumn::set(const size_t & index, string_view text) {
+	setCode(index, findCode(text));
+}
+
+// Function to replace the column with number entries which are all the same
+void stringColumn::assign(const size_t & number, string_view text) {
+	clear();
+	table.add(text);
+	count = number;
+}
+
+// Function to remove every entry
+void stringColumn::clear() {
+	table.clear();
+	codes.clear();
+	count = 0;
+	lastCode = 0;
+}
+
+// Function returning true if every entry is the same
+bool stringColumn::isConstant() const {
+	if (codes.empty()) { return (true); }
+	return (all_of(codes.begin(), codes.end(), [this](const uint32_t & code) { return (code == codes[0]); }));
+}
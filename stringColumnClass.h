@@ -0,0 +1,71 @@
+// This header contains the stringColumn class. This is the column used to store the values, errors and statistical errors of
+// string measurements. Each different string is stored once in a table, and each entry of the column is only the id of its string,
+// so columns with few different strings (eg. "heads" and "tails", or "N/A") take up very little memory
+// Functions defined in the stringColumnClass.cpp file
+
+#ifndef STRING_COLUMN_CLASS_H
+#define STRING_COLUMN_CLASS_H
+
+using namespace std;
+#include<string>
+#include<string_view>
+#include<vector>
+#include<cstdint>
+#include"stringTableClass.h"
+
+// Class for a dictionary encoded column of strings
+class stringColumn {
+private:
+	// Table of the different strings in the column
+	stringTable table;
+	// Id in the table of each entry. This is left empty while every entry has id 0, which is the same as all entries being equal
+	vector<uint32_t> codes;
+	// Number of entries
+	size_t count;
+	// Id of the string last added, checked before the table since strings are often the same as the one before
+	uint32_t lastCode;
+
+	// Function to store the id of an entry, creating the codes once a second string is found
+	void setCode(const size_t & index, const uint32_t & code);
+
+	// Function returning the id of a string, adding it to the table if it is new
+	uint32_t findCode(string_view text);
+
+public:
+	// Default constructor
+	stringColumn();
+
+	// Number of entries stored
+	size_t size() const { return (count); }
+	bool empty() const { return (count == 0); }
+
+	// Function to make space for a number of entries without adding them
+	void reserve(const size_t & capacity);
+
+	// Function to add an entry to the end of the column
+	void push_back(string_view text);
+
+	// Function to overwrite an existing entry
+	void set(const size_t & index, string_view text);
+
+	// Function to replace the column with number entries which are all the same
+	void assign(const size_t & number, string_view text);
+
+	// Function to remove every entry
+	void clear();
+
+	// Accesor functions. Entries with the same id are always the same string, so they can be compared by id
+	const string & operator[](const size_t & index) const { return (table.getString(getCode(index))); }
+	uint32_t getCode(const size_t & index) const { return (codes.empty() ? 0 : codes[index]); }
+	// Array of the id of every entry, or NULL while every entry has id 0
+	const uint32_t* getCodes() const { return (codes.empty() ? NULL : codes.data()); }
+	const stringTable & getTable() const { return (table); }
+
+	// Function returning true if every entry is the same
+	bool isConstant() const;
+
+	// Number of bytes allocated by the column, including its table
+	size_t getMemoryUsage() const { return (codes.capacity() * sizeof(uint32_t) + table.getMemoryUsage()); }
+};
+
+#endif
@@ -0,0 +1,53 @@
+// This file contains the definitions for the stringTableClass.h file
+
+using namespace std;
+#include<string>
+#include<string_view>
+
+#include"stringTableClass.h"
+
+// Default constructor
+stringTable::stringTable() : memoryUsage{ 0 } {}
+
+// Copy constructor
+stringTable::stringTable(const stringTable &table) : memoryUsage{ 0 } {
+	ids.reserve(table.size());
+	for (size_t i{ 0 }; i < table.size(); i++) { add(table.getString(uint32_t(i))); }
+}
+
+// Copy assignment operator
+stringTable & stringTable::operator=(const stringTable &table) {
+	if (&table == this) { return (*this); }
+	clear();
+	ids.reserve(table.size());
+	for (size_t i{ 0 }; i < table.size(); i++) { add(table.getString(uint32_t(i))); }
+	return (*this);
+}
+
+// Function returning the id of a string, adding it to the table if it is new
+uint32_t stringTable::add(string_view text) {
+	unordered_map<string_view, uint32_t>::const_iterator found{ ids.find(text) };
+	if (found != ids.end()) { return (found->second); }
+	strings.emplace_back(text);
+	uint32_t id{ uint32_t(strings.size() - 1) };
+	ids.emplace(string_view{ strings.back() }, id);
+	// Each string is stored once in the deque and once in the index (as a view and id, with about two pointers of overhead)
+	memoryUsage += sizeof(string) + sizeof(string_view) + sizeof(uint32_t) + 2 * sizeof(void*);
+	if (strings.back().capacity() > string().capacity()) { memoryUsage += strings.back().capacity() + 1; }
+	return (id);
+}
+
+// Function to find the id of a string
+bool stringTable::find(string_view text, uint32_t & id) const {
+	unordered_map<string_view, uint32_t>::const_iterator found{ ids.find(text) };
+	if (found == ids.end()) { return (false); }
+	id = found->second;
+	return (true);
+}
+
+// Function to remove every string
+void stringTable::clear() {
+	ids.clear();
+	strings.clear();
+	memoryUsage = 0;
+}
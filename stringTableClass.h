@@ -0,0 +1,52 @@
+// This header contains the stringTable class. This gives each different string a small integer id the first time it is seen,
+// so repeated strings can be counted or grouped by comparing ids instead of whole strings
+// Functions defined in the stringTableClass.cpp file
+
+#ifndef STRING_TABLE_CLASS_H
+#define STRING_TABLE_CLASS_H
+
+using namespace std;
+#include<string>
+#include<string_view>
+#include<deque>
+#include<unordered_map>
+#include<cstdint>
+
+// Class for a table of different strings. Ids count up from 0 in the order the strings were added
+class stringTable {
+private:
+	// Strings in the table by id. A deque never moves its strings, so the index can refer to them without copies
+	deque<string> strings;
+	// Index from each string to its id
+	unordered_map<string_view, uint32_t> ids;
+	// Number of bytes allocated by the table, kept up to date as strings are added
+	size_t memoryUsage;
+
+public:
+	// Default constructor
+	stringTable();
+
+	// Copy constructor and assignment operator. The index of the copy has to refer to its own strings
+	stringTable(const stringTable &table);
+	stringTable & operator=(const stringTable &table);
+
+	// Move constructor and assignment operator
+	stringTable(stringTable &&table) = default;
+	stringTable & operator=(stringTable &&table) = default;
+
+	// Function returning the id of a string, adding it to the table if it is new
+	uint32_t add(string_view text);
+
+	// Function to find the id of a string. Returns false if it isn't in the table
+	bool find(string_view text, uint32_t & id) const;
+
+	// Accesor functions
+	const string & getString(const uint32_t & id) const { return (strings[id]); }
+	size_t size() const { return (strings.size()); }
+	size_t getMemoryUsage() const { return (memoryUsage); }
+
+	// Function to remove every string
+	void clear();
+};
+
+#endif
@@ -2,118 +2,110 @@
 
 using namespace std;
 #include<iostream>
+#include<cstdio>
+#include<cctype>
+#include<charconv>
 #include"timestampClass.h"
-#include"generalHeader.h"
 
 // Default constructor
 timestamp::timestamp() {
-	date = { 0, 0, 0, 0, 0, 0 };
-	timestampCounter++;
+	packedDate = 0;
 }
 
 // Paramatrised constructor with 6 ints
-timestamp::timestamp(const int & YY, const int & MM, const int & DD, const int & hh, const int & mm, const int & ss) {
-	date = { YY, MM, DD, hh, mm, ss };
-	timestampCounter++;
+timestamp::timestamp(const int & YY, const int & MM, const int & DD, const int & hh, const int & mm, const int & ss): timestamp() {
+	if (!packDate(YY, MM, DD, hh, mm, ss, packedDate)) {
+		cout << "Warning: timestamp input was invalid. Setting to default 0000/00/00 00:00:00" << endl;
+	}
 }
 
 // Paramatrised constructor with a vector
 timestamp::timestamp(const vector<int> & input): timestamp() {
-	if (input.size() == 6) { date = input; }
-	else { cout << "Warning: timestamp input was invalid. Setting to default 0000/00/00 00:00:00" << endl; }
+	if (input.size() != 6 || !packDate(input[0], input[1], input[2], input[3], input[4], input[5], packedDate)) {
+		cout << "Warning: timestamp input was invalid. Setting to default 0000/00/00 00:00:00" << endl;
+	}
 }
 
 // Paramatrised constructor with a string
 timestamp::timestamp(const string & input): timestamp() {
-
-	// Check string is valid
-	if (!timestamp::validTimeStamp(input)) {
+	// Parse and check the string in one go. The timestamp is left as the default if it is invalid
+	if (!timestamp::parseTimeStamp(input, *this)) {
 		cout << "Warning: timestamp input was invalid. Setting to default 0000/00/00 00:00:00" << endl;
 	}
-	else {
-		// Vector of strings to store all the substrings corresponding to parts of the date and time
-		vector<string> timeStampStrings;	// <year,month,day,hour,minute,second>
-		// Vector of ints giving important positions in the line (Colons, slashes, spaces)
-		vector<int> linePositions;	// <slash1,slash2,space,colon1,colon2>
-
-		// Get relevant positions (The last position being the end of the string)
-		// Note the -1 at beginning is to make loop later work. +1 must be added to some positions to miss the / and : in substrings
-		linePositions.push_back(-1);
-		linePositions.push_back(input.find('/'));
-		linePositions.push_back(input.find('/', linePositions[1] + 1));
-		linePositions.push_back(input.find(' '));
-		linePositions.push_back(input.find(':'));
-		linePositions.push_back(input.find(':', linePositions[4] + 1));
-		linePositions.push_back(input.size());
-		
-		// Get the substrings, removing white space
-		for (int i{ 0 }; i < 6; i++) {
-			string tempString{ input.substr(linePositions[i] + 1, linePositions[i + 1] - linePositions[i] - 1) };
-			timeStampStrings.push_back(removeWhitespace(tempString));
-		}
-
-		// Now check if all strings are valid numbers
-		for (size_t i{ 0 }; i < timeStampStrings.size(); i++) {
-			date[i] = stoi(timeStampStrings[i]);
-		}
-	}
 }
 
-// Copy constructor
-timestamp::timestamp(const timestamp &tt): timestamp() { 
-	date = tt.date; 
+// Function to pack the six parts of a date in to one integer. Returns false if any part doesn't fit in its bits
+bool timestamp::packDate(const int & YY, const int & MM, const int & DD, const int & hh, const int & mm, const int & ss, uint64_t & output) {
+	if (YY < 0 || YY > maxYear) { return (false); }
+	if (MM < 0 || MM > maxField || DD < 0 || DD > maxField) { return (false); }
+	if (hh < 0 || hh > maxField || mm < 0 || mm > maxField || ss < 0 || ss > maxField) { return (false); }
+	output = (uint64_t(YY) << 40) | (uint64_t(MM) << 32) | (uint64_t(DD) << 24) | (uint64_t(hh) << 16) | (uint64_t(mm) << 8) | uint64_t(ss);
+	return (true);
 }
 
-// Move constructor
-timestamp::timestamp(timestamp &&tt): timestamp() {
-	date = tt.date;
-	// Destroy data in rvalue timestamp
-	tt.date.clear();
+// Accesor function for any of the six parts of the date (0 is the year, 5 is the second)
+int timestamp::getField(const int & index) const {
+	if (index == 0) { return (int(packedDate >> 40)); }
+	return (int((packedDate >> (8 * (5 - index))) & maxField));
 }
 
-// Destructor
-timestamp::~timestamp(){
-	timestampCounter--;
+// Difference between two timestamps in seconds
+long long timestamp::operator-(const timestamp &tt) const {
+	return (getTotalSeconds() - tt.getTotalSeconds());
 }
 
-// Copy assignment operator
-timestamp & timestamp::operator=(const timestamp & tt){
-	// Check for self assignment 
-	if (&tt == this) { return (*this); }
-	date = tt.date;
-	return (*this);
+// Accesor functions for specific parts of the date
+int timestamp::getYear() const { return getField(0); }
+int timestamp::getMonth() const { return getField(1); }
+int timestamp::getDay() const { return getField(2); }
+int timestamp::getHour() const { return getField(3); }
+int timestamp::getMinute() const { return getField(4); }
+int timestamp::getSecond() const { return getField(5); }
+
+// Accesor function for the number of seconds since 0000/01/01 00:00:00
+// Months outside 1-12 (eg. the default 0000/00/00) are carried in to the year so that differences are still consistent
+long long timestamp::getTotalSeconds() const {
+	long long totalMonths{ 12 * (long long)getYear() + getMonth() - 1 };
+	long long year{ (totalMonths >= 0 ? totalMonths : totalMonths - 11) / 12 };
+	long long month{ totalMonths - 12 * year + 1 };
+	// Count days with years starting in March, so the leap day is always the last day of a year
+	if (month <= 2) { year--; }
+	long long era{ (year >= 0 ? year : year - 399) / 400 };
+	long long yearOfEra{ year - 400 * era };
+	long long dayOfYear{ (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + getDay() - 1 };
+	long long days{ 146097 * era + 365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100 + dayOfYear + 60 };
+	return (((days * 24 + getHour()) * 60 + getMinute()) * 60 + getSecond());
 }
 
-// Move assignment operator
-timestamp & timestamp::operator=(timestamp &&tt) {
-	// Check for self assignment 
-	if (&tt == this) { return (*this); }
-	date = tt.date;
-	// Destroy data in rvalue timestamp
-	tt.date.clear();
-	return (*this);
+// Function to make a timestamp from a packed integer. Every 64 bit integer is a valid packed date, so no check is needed
+timestamp timestamp::fromPackedDate(const uint64_t & packed) {
+	timestamp output;
+	output.packedDate = packed;
+	return (output);
 }
 
-// Accesor functions for specific parts of the date
-int timestamp::getYear() const { return date[0]; }
-int timestamp::getMonth() const { return date[1]; }
-int timestamp::getDay() const { return date[2]; }
-int timestamp::getHour() const { return date[3]; }
-int timestamp::getMinute() const { return date[4]; }
-int timestamp::getSecond() const { return date[5]; }
-
-// Static accesor function to check the number of measurements in program (And hence number of measurements)
-size_t timestamp::getTimestampCounter() { return timestampCounter; }
-
 // Accesor function for a vector representing the full date
-vector<int> timestamp::getTimeVector() const { return date; }
+vector<int> timestamp::getTimeVector() const {
+	return (vector<int>{ getYear(), getMonth(), getDay(), getHour(), getMinute(), getSecond() });
+}
 
-// Accesor function for a vector representing the full date
+// Accesor function for a string representing the full date
 string timestamp::getTimeString() const {
 	string output;
-	output = to_string(date[0]) + "/" + to_string(date[1]) + "/" + to_string(date[2]) + "  ";
-	output += to_string(date[3]) + ":" + to_string(date[4]) + ":" + to_string(date[5]);
-	return output;
+	appendTimeString(output);
+	return (output);
+}
+
+// Function to add the string representing the full date to the end of another string (Format YYYY/MM/DD  hh:mm:ss)
+void timestamp::appendTimeString(string & output) const {
+	const char separators[6]{ '/', '/', ' ', ':', ':', '\0' };
+	char digits[12];
+	for (int i{ 0 }; i < 6; i++) {
+		to_chars_result result{ to_chars(digits, digits + sizeof(digits), getField(i)) };
+		output.append(digits, result.ptr);
+		if (separators[i] == ' ') { output += "  "; }
+		else if (separators[i] != '\0') { output += separators[i]; }
+	}
 }
 
 // Overload << operator for output to the ostream
@@ -132,43 +124,46 @@ istream & operator >> (istream &is, timestamp &tt) {
 }
 
 // A function to check if a string is a valid timestamp. Made static to be called without an instance of timeclass
-bool timestamp::validTimeStamp(const string input) {
-	// Boolean value telling us if an error has been found with the input
-	bool validTimeStamp{ true };
-	// Vector of strings to store all the substrings corresponding to parts of the date and time
-	vector<string> timeStampStrings;	// <year,month,day,hour,minute,second>
-	// Vector of ints giving important positions in the line (Colons, slashes, spaces)
-	vector<int> linePositions;	// <slash1,slash2,space,colon1,colon2>
-
-	// Count number of / and :
-	size_t numSlash, numColon;
-	numSlash = count(input.begin(), input.end(), '/');
-	numColon = count(input.begin(), input.end(), ':');
-	// Check if there are two of each
-	if (numSlash != 2 || numColon != 2) { return (false); }
-	else {
-		// Get relevant positions (The last position being the end of the string)
-		// Note the -1 at beginning is to make loop later work. +1 must be added to some positions to miss the / and : in substrings
-		linePositions.push_back(-1);
-		linePositions.push_back(input.find('/'));
-		linePositions.push_back(input.find('/', linePositions[1] + 1));
-		linePositions.push_back(input.find(' '));
-		linePositions.push_back(input.find(':'));
-		linePositions.push_back(input.find(':', linePositions[4] + 1));
-		linePositions.push_back(input.size());
-
-		// Get the substrings, removing white space
-		for (int i{ 0 }; i < 6; i++) {
-			string tempString{ input.substr(linePositions[i] + 1, linePositions[i + 1] - linePositions[i] - 1) };
-			timeStampStrings.push_back(removeWhitespace(tempString));
-		}
+bool timestamp::validTimeStamp(string_view input) {
+	timestamp tempTime;
+	return (parseTimeStamp(input, tempTime));
+}
 
-		// Now check if all strings are valid numbers
-		for (size_t i{ 0 }; i < timeStampStrings.size(); i++) {
-			if (!isStringInt(timeStampStrings[i])) { return(false); }
+// A function to read a timestamp from a string in a single pass, without making any temporary strings
+// Expected format is YYYY/MM/DD hh:mm:ss, with any number of spaces around each part (At least one between date and time)
+// Returns false if the string is not a valid timestamp, in which case output is left unchanged
+bool timestamp::parseTimeStamp(string_view input, timestamp & output) {
+	// Characters expected after each of the first five parts of the timestamp
+	const char separators[5]{ '/', '/', ' ', ':', ':' };
+	int fields[6];	// {year, month, day, hour, minute, second}
+	size_t position{ 0 };
+
+	for (int i{ 0 }; i < 6; i++) {
+		// Skip spaces before the number
+		while (position < input.size() && input[position] == ' ') { position++; }
+		// Read the digits of the number. More than 8 digits can never fit in the packed timestamp
+		int digits{ 0 };
+		fields[i] = 0;
+		while (position < input.size() && isdigit((unsigned char)input[position])) {
+			if (digits == 8) { return (false); }
+			fields[i] = 10 * fields[i] + (input[position] - '0');
+			digits++; position++;
+		}
+		if (digits == 0) { return (false); }
+		if (i == 5) { break; }
+		// Check for the separator. The space between date and time is skipped at the start of the next loop
+		if (separators[i] == ' ') {
+			if (position == input.size() || input[position] != ' ') { return (false); }
+		}
+		else {
+			while (position < input.size() && input[position] == ' ') { position++; }
+			if (position == input.size() || input[position] != separators[i]) { return (false); }
+			position++;
 		}
-
-		// If code reaches this point timestamp is valid
-		return (true);
 	}
+	// Only spaces are allowed after the seconds
+	while (position < input.size() && input[position] == ' ') { position++; }
+	if (position != input.size()) { return (false); }
+
+	return (packDate(fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], output.packedDate));
 }
@@ -6,6 +6,10 @@
 
 using namespace std;
 #include<vector>
+#include<string>
+#include<iostream>
+#include<cstdint>
+#include<string_view>
 
 // Class to store the timestamp of a measurement
 class timestamp {
@@ -14,11 +18,20 @@ class timestamp {
 	// Overload >> operator for input from the istream
 	friend istream & operator>>(istream &is, timestamp &tt);
 private:
-	// Integers storing the timestamp information (format YYYY/MM/DD  hh:mm:ss)
-	vector<int> date;	// {year, month, day, hour, minute, second}
-	// Static data to see the number of timestamps in the program (1:1 correspondance with measurement)
-	static size_t timestampCounter;
+	// All six parts of the timestamp packed in to a single integer (format YYYY/MM/DD  hh:mm:ss)
+	// From the most significant bits: year (24 bits), month, day, hour, minute, second (8 bits each)
+	// Since the year is in the highest bits, comparing two packed values compares the two dates
+	uint64_t packedDate;
+
+	// Function to pack the six parts of a date in to one integer. Returns false if any part doesn't fit in its bits
+	static bool packDate(const int & YY, const int & MM, const int & DD, const int & hh, const int & mm, const int & ss, uint64_t & output);
+	// Accesor function for any of the six parts of the date (0 is the year, 5 is the second)
+	int getField(const int & index) const;
 public:
+	// Largest values that can be stored in the year and in the other parts of the date
+	static const int maxYear{ 0xFFFFFF };
+	static const int maxField{ 0xFF };
+
 	// Default constructor
 	timestamp();
 	// Paramatrised constructor with 6 ints
@@ -28,17 +41,28 @@ public:
 	// Paramatrised constructor with a string
 	timestamp(const string & input);
 
+	// Copy and move operations just copy the packed integer, since the timestamp owns no memory
 	// Copy constructor
-	timestamp(const timestamp &tt);
+	timestamp(const timestamp &tt) = default;
 	// Move constructor
-	timestamp(timestamp &&tt);
+	timestamp(timestamp &&tt) = default;
 	// Destructor
-	~timestamp();
+	~timestamp() = default;
 
 	// Copy assignment operator
-	timestamp & operator=(const timestamp &tt);
+	timestamp & operator=(const timestamp &tt) = default;
 	// Move assignment operator
-	timestamp & operator=(timestamp &&tt);
+	timestamp & operator=(timestamp &&tt) = default;
+
+	// Comparison operators. These compare the packed integers so are all O(1)
+	bool operator==(const timestamp &tt) const { return (packedDate == tt.packedDate); }
+	bool operator!=(const timestamp &tt) const { return (packedDate != tt.packedDate); }
+	bool operator<(const timestamp &tt) const { return (packedDate < tt.packedDate); }
+	bool operator>(const timestamp &tt) const { return (packedDate > tt.packedDate); }
+	bool operator<=(const timestamp &tt) const { return (packedDate <= tt.packedDate); }
+	bool operator>=(const timestamp &tt) const { return (packedDate >= tt.packedDate); }
+	// Difference between two timestamps in seconds
+	long long operator-(const timestamp &tt) const;
 
 	// Accesor functions for specific parts of the date
 	int getYear() const;
@@ -47,14 +71,22 @@ public:
 	int getHour() const;
 	int getMinute() const;
 	int getSecond() const;
-	// Static accesor function to check the number of measurements in program (And hence number of measurements)
-	static size_t getTimestampCounter();
+	// Accesor function for the packed integer representing the full date
+	uint64_t getPackedDate() const { return (packedDate); }
+	// Accesor function for the number of seconds since 0000/01/01 00:00:00
+	long long getTotalSeconds() const;
+	// Function to make a timestamp from a packed integer, as returned by getPackedDate. Used when reading binary save files
+	static timestamp fromPackedDate(const uint64_t & packed);
 	// Accesor function for a vector representing the full date
 	vector<int> getTimeVector() const;
 	// Accesor function for a string representing the full date
 	string getTimeString() const;
+	// Function to add the string representing the full date to the end of another string, without making a temporary string
+	void appendTimeString(string & output) const;
 	// A function to check if a string is a valid timestamp. Made static to be called without an instance of timeclass
-	static bool validTimeStamp(const string input);
+	static bool validTimeStamp(string_view input);
+	// A function to read a timestamp from a string in a single pass. Returns false, instead of throwing, if the string isn't valid
+	static bool parseTimeStamp(string_view input, timestamp & output);
 };
 
-#endif
\ No newline at end of file
+#endif